@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <ArduinoJson.h>
+#include "Bench.hpp"
+
+namespace Bench {
+
+    volatile uintptr_t sink = 0;
+
+    struct Result {
+        std::string name;
+        double nsPerOp;
+        size_t bytes;
+    };
+
+    std::vector<Result> results;
+
+    void report(const char * name, double nsPerOp, size_t bytes) {
+        if (bytes > 0) {
+            printf("%-48s %12.1f ns/op %8u bytes\n", name, nsPerOp, static_cast<unsigned>(bytes));
+        } else {
+            printf("%-48s %12.1f ns/op\n", name, nsPerOp);
+        }
+        results.push_back({name, nsPerOp, bytes});
+    }
+
+    bool save(const char * path) {
+        DynamicJsonDocument doc(JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(results.size()) + results.size() * JSON_OBJECT_SIZE(3));
+        auto array = doc.createNestedArray("results");
+        for (auto & result : results) {
+            auto entry = array.createNestedObject();
+            // names are kept in the results, so no copies
+            entry["name"] = result.name.c_str();
+            entry["nsPerOp"] = result.nsPerOp;
+            entry["bytes"] = result.bytes;
+        }
+        if (doc.overflowed()) return false;
+        auto file = fopen(path, "w");
+        if (file == nullptr) {
+            printf("could not write %s\n", path);
+            return false;
+        }
+        std::string json;
+        serializeJsonPretty(doc, json);
+        auto written = fwrite(json.data(), 1, json.size(), file);
+        fclose(file);
+        return written == json.size();
+    }
+
+    bool compare(const char * path, double threshold) {
+        auto file = fopen(path, "r");
+        if (file == nullptr) {
+            printf("could not read %s\n", path);
+            return false;
+        }
+        std::string json;
+        char chunk[256];
+        size_t length;
+        while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            json.append(chunk, length);
+        }
+        fclose(file);
+        // one object per result, and every string fits in the text's length
+        auto entries = static_cast<size_t>(std::count(json.begin(), json.end(), '{'));
+        DynamicJsonDocument doc(entries * (JSON_ARRAY_SIZE(1) + JSON_OBJECT_SIZE(3)) + json.size());
+        if (deserializeJson(doc, json)) {
+            printf("could not parse %s\n", path);
+            return false;
+        }
+
+        printf("\n%-48s %12s %12s %8s\n", "compared to baseline", "ns/op", "baseline", "change");
+        auto regressed = false;
+        for (auto & result : results) {
+            JsonObject baseline;
+            for (JsonVariant entry : doc["results"].as<JsonArray>()) {
+                if (result.name == entry["name"].as<const char *>()) {
+                    baseline = entry.as<JsonObject>();
+                    break;
+                }
+            }
+            if (baseline.isNull()) {
+                printf("%-48s %12.1f %12s\n", result.name.c_str(), result.nsPerOp, "new");
+                continue;
+            }
+            auto baselineNs = baseline["nsPerOp"].as<double>();
+            auto change = baselineNs > 0 ? result.nsPerOp / baselineNs - 1 : 0;
+            auto slower = change > threshold;
+            auto bigger = result.bytes > baseline["bytes"].as<size_t>();
+            printf("%-48s %12.1f %12.1f %+7.0f%%%s%s\n", result.name.c_str(), result.nsPerOp, baselineNs, change * 100,
+                slower ? " SLOWER" : "", bigger ? " BIGGER" : "");
+            regressed = regressed || slower || bigger;
+        }
+        return !regressed;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Bench {
+
+    // written by every timed operation so the optimizer can't drop them
+    extern volatile uintptr_t sink;
+
+    // Mean time in nanoseconds of `iterations` calls to `op`
+    template <class Op>
+    double nsPerOp(size_t iterations, Op op) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t iteration = 0; iteration < iterations; iteration++) {
+            sink = sink + static_cast<uintptr_t>(op());
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+
+    // Prints and records a result. bytes is the JsonDocument memory the
+    // operation needs, 0 where no document is involved.
+    void report(const char * name, double nsPerOp, size_t bytes = 0);
+
+    // Writes the recorded results as JSON:
+    // {"results": [{"name": ..., "nsPerOp": ..., "bytes": ...}, ...]}
+    bool save(const char * path);
+
+    // Compares the recorded results with ones saved earlier. A result
+    // regresses when it is more than `threshold` (0.1 for 10%) slower or
+    // needs any more bytes. Returns false on a regression or a bad file.
+    bool compare(const char * path, double threshold);
+
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include "../src/BurpSerialization/Parser.hpp"
+#include "../src/BurpSerialization/BinaryEncoder.hpp"
+#include "../src/BurpSerialization/BinaryDecoder.hpp"
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "Binary.hpp"
+
+namespace Binary {
+
+    constexpr size_t bufferSize = 1024;
+    constexpr size_t iterations = 100000;
+
+    void run() {
+        Bench::Config config;
+        char json[bufferSize];
+        uint8_t binary[bufferSize];
+        char strings[bufferSize];
+
+        BurpSerialization::Writer writer(json, bufferSize);
+        config.root.write(writer);
+        auto jsonLength = writer.length();
+        BurpSerialization::BinaryEncoder encoder(binary, bufferSize);
+        encoder.encode(config.root);
+        auto binaryLength = encoder.length();
+        printf("%-48s %12u bytes\n", "config as positional binary", static_cast<unsigned>(binaryLength));
+
+        Bench::report("config encode positional binary", Bench::nsPerOp(iterations, [&]() {
+            encoder.encode(config.root);
+            return encoder.length();
+        }));
+        BurpSerialization::Parser parser(config.root, strings, bufferSize, {0, 1, 2, 3, 4});
+        Bench::report("config Parser JSON, for comparison", Bench::nsPerOp(iterations, [&]() {
+            parser.begin();
+            parser.write(json, jsonLength);
+            return parser.end();
+        }));
+        BurpSerialization::BinaryDecoder decoder(strings, bufferSize, {0, 1, 2, 3, 4});
+        Bench::report("config decode positional binary", Bench::nsPerOp(iterations, [&]() {
+            return decoder.decode(config.root, binary, binaryLength);
+        }));
+    }
+
+}
\ No newline at end of file
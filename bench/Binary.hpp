@@ -0,0 +1,7 @@
+#pragma once
+
+namespace Binary {
+
+    void run();
+
+}
\ No newline at end of file
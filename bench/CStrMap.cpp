@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include "../src/BurpSerialization/CStrMap.hpp"
+#include "../src/BurpSerialization/IndexedCStrMap.hpp"
+#include "Bench.hpp"
+#include "CStrMap.hpp"
+
+namespace CStrMap {
+
+    constexpr size_t iterations = 1000000;
+
+    template <size_t count>
+    class Fixture {
+
+        public:
+
+            using Linear = BurpSerialization::CStrMap<uint16_t, count>;
+            using Indexed = BurpSerialization::IndexedCStrMap<uint16_t, count>;
+
+            Fixture() :
+                _choices(_makeChoices()),
+                _linear(_choices, {0, 1, 2, 3}, _value),
+                _indexed(_choices, {0, 1, 2, 3}, _value)
+            {}
+
+            void run() {
+                char name[64];
+                snprintf(name, sizeof(name), "CStrMap<%u> linear deserialize", static_cast<unsigned>(count));
+                Bench::report(name, _deserialize(_linear));
+                snprintf(name, sizeof(name), "CStrMap<%u> indexed deserialize", static_cast<unsigned>(count));
+                Bench::report(name, _deserialize(_indexed));
+            }
+
+        private:
+
+            std::array<std::array<char, 16>, count> _keys;
+            const typename Linear::Choices _choices;
+            typename Linear::Value _value;
+            const Linear _linear;
+            const Indexed _indexed;
+
+            typename Linear::Choices _makeChoices() {
+                typename Linear::Choices choices;
+                for (size_t index = 0; index < count; index++) {
+                    snprintf(_keys[index].data(), _keys[index].size(), "choice%u", static_cast<unsigned>(index));
+                    choices[index] = {_keys[index].data(), static_cast<uint16_t>(index)};
+                }
+                return choices;
+            }
+
+            // every key in turn, so the linear scan is measured at its average
+            double _deserialize(const BurpSerialization::Field & field) {
+                StaticJsonDocument<16> doc;
+                size_t index = 0;
+                return Bench::nsPerOp(iterations, [&]() {
+                    doc.set(static_cast<const char *>(_keys[index].data()));
+                    index = (index + 1) % count;
+                    return field.deserialize(doc.as<JsonVariant>());
+                });
+            }
+
+    };
+
+    void run() {
+        Fixture<4>().run();
+        Fixture<16>().run();
+        Fixture<64>().run();
+    }
+
+}
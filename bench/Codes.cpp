@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include "Bench.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "Codes.hpp"
+
+namespace Codes {
+
+    constexpr size_t docSize = 1024;
+    constexpr size_t iterations = 200000;
+
+    using namespace BurpSerialization;
+
+    // the fields of Bench::Config, only sized so never constructed
+    template <template <class> class Codes>
+    struct Schema {
+
+        using Object3 = Object<3, Codes>;
+        using Object4 = Object<4, Codes>;
+
+        const BasicCStr<Codes> name;
+        const BasicMacAddress<Codes> id;
+        const Scalar<uint8_t, Codes> brightness;
+        const Object3 device;
+        const BasicCStr<Codes> ssid;
+        const BasicIPv4<Codes> address;
+        const BasicIPv4<Codes> gateway;
+        const BasicIPv4<Codes> netmask;
+        const Object4 network;
+        const BasicPWMLevels<Codes> levels;
+        const Scalar<uint32_t, Codes> uptime;
+        const Scalar<uint16_t, Codes> restarts;
+        const Scalar<int32_t, Codes> offset;
+        const Scalar<bool, Codes> enabled;
+        const Object4 counters;
+        const Object4 root;
+
+    };
+
+    const SharedIPv4::StatusCodes ipv4Codes PROGMEM = {0, 1, 2, 3, 4, 5, 6};
+    const SharedPWMLevels::StatusCodes pwmLevelsCodes PROGMEM = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+    // the time cost is the read of each code out of the table
+    template <class Type>
+    void measure(const char * name, const Type & field, const char * json) {
+        DynamicJsonDocument doc(docSize);
+        deserializeJson(doc, json);
+        auto variant = doc.as<JsonVariant>();
+        auto ns = Bench::nsPerOp(iterations, [&]() {
+            return field.deserialize(variant);
+        });
+        Bench::report(name, ns);
+    }
+
+    void run() {
+        printf("%-48s %12u bytes\n", "Config fields, copied codes", static_cast<unsigned>(sizeof(Schema<CopiedCodes>)));
+        printf("%-48s %12u bytes\n", "Config fields, shared codes", static_cast<unsigned>(sizeof(Schema<SharedCodes>)));
+
+        const char * addressJson = "\"192.168.1.42\"";
+        IPv4::Value address;
+        SharedIPv4::Value sharedAddress;
+        measure("IPv4 copied codes deserialize", IPv4({0, 1, 2, 3, 4, 5, 6}, address), addressJson);
+        measure("IPv4 shared codes deserialize", SharedIPv4(&ipv4Codes, sharedAddress), addressJson);
+        const char * levelsJson = "[15,30,45,60,75,90,105,120,135,150,165,180,195,210,225,240]";
+        PWMLevels::Value levels;
+        SharedPWMLevels::Value sharedLevels;
+        measure("PWMLevels copied codes deserialize", PWMLevels({0, 1, 2, 3, 4, 5, 6, 7, 8}, levels), levelsJson);
+        measure("PWMLevels shared codes deserialize", SharedPWMLevels(&pwmLevelsCodes, sharedLevels), levelsJson);
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string.h>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+
+namespace Bench {
+
+    // A device config with the kind of nesting and field mix seen in practice
+    class Config {
+
+        public:
+
+            struct {
+                bool isNull;
+                struct {
+                    bool isNull;
+                    const char * name;
+                    BurpSerialization::MacAddress::Value id;
+                    BurpSerialization::Scalar<uint8_t>::Value brightness;
+                } device;
+                struct {
+                    bool isNull;
+                    const char * ssid;
+                    BurpSerialization::IPv4::Value address;
+                    BurpSerialization::IPv4::Value gateway;
+                    BurpSerialization::IPv4::Value netmask;
+                } network;
+                BurpSerialization::PWMLevels::Value levels;
+                struct {
+                    bool isNull;
+                    BurpSerialization::Scalar<uint32_t>::Value uptime;
+                    BurpSerialization::Scalar<uint16_t>::Value restarts;
+                    BurpSerialization::Scalar<int32_t>::Value offset;
+                    BurpSerialization::Scalar<bool>::Value enabled;
+                } counters;
+            } value;
+
+            const BurpSerialization::Field & root = _root;
+
+            Config() :
+                _name(1, 32, {0, 1, 2, 3, 4}, value.device.name),
+                _id({0, 1, 2, 3, 4, 5, 6, 7}, value.device.id),
+                _brightness({0, 1, 2}, value.device.brightness),
+                _device({
+                    Object3::Entry({"name", &_name}),
+                    Object3::Entry({"id", &_id}),
+                    Object3::Entry({"brightness", &_brightness})
+                }, {0, 1, 2}, value.device.isNull),
+                _ssid(1, 32, {0, 1, 2, 3, 4}, value.network.ssid),
+                _address({0, 1, 2, 3, 4, 5, 6}, value.network.address),
+                _gateway({0, 1, 2, 3, 4, 5, 6}, value.network.gateway),
+                _netmask({0, 1, 2, 3, 4, 5, 6}, value.network.netmask),
+                _network({
+                    Object4::Entry({"ssid", &_ssid}),
+                    Object4::Entry({"address", &_address}),
+                    Object4::Entry({"gateway", &_gateway}),
+                    Object4::Entry({"netmask", &_netmask})
+                }, {0, 1, 2}, value.network.isNull),
+                _levels({0, 1, 2, 3, 4, 5, 6, 7, 8}, value.levels),
+                _uptime({0, 1, 2}, value.counters.uptime),
+                _restarts({0, 1, 2}, value.counters.restarts),
+                _offset({0, 1, 2}, value.counters.offset),
+                _enabled({0, 1, 2}, value.counters.enabled),
+                _counters({
+                    Object4::Entry({"uptime", &_uptime}),
+                    Object4::Entry({"restarts", &_restarts}),
+                    Object4::Entry({"offset", &_offset}),
+                    Object4::Entry({"enabled", &_enabled})
+                }, {0, 1, 2}, value.counters.isNull),
+                _root({
+                    Object4::Entry({"device", &_device}),
+                    Object4::Entry({"network", &_network}),
+                    Object4::Entry({"levels", &_levels}),
+                    Object4::Entry({"counters", &_counters})
+                }, {0, 1, 2}, value.isNull)
+            {
+                value = {};
+                value.device.name = "living room lights";
+                const uint8_t id[] = {0x5c, 0xcf, 0x7f, 0x12, 0x34, 0x56};
+                memcpy(value.device.id.value, id, sizeof(id));
+                value.device.brightness.value = 200;
+                value.network.ssid = "home network";
+                value.network.address.value = 0xc0a8012a;
+                value.network.gateway.value = 0xc0a80101;
+                value.network.netmask.value = 0xffffff00;
+                for (size_t index = 0; index < 16; index++) {
+                    value.levels.list[index] = (index + 1) * 15;
+                }
+                value.levels.length = 16;
+                value.counters.uptime.value = 3600000;
+                value.counters.restarts.value = 12;
+                value.counters.offset.value = -300;
+                value.counters.enabled.value = true;
+            }
+
+        private:
+
+            using Object3 = BurpSerialization::Object<3>;
+            using Object4 = BurpSerialization::Object<4>;
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::MacAddress _id;
+            const BurpSerialization::Scalar<uint8_t> _brightness;
+            const Object3 _device;
+            const BurpSerialization::CStr _ssid;
+            const BurpSerialization::IPv4 _address;
+            const BurpSerialization::IPv4 _gateway;
+            const BurpSerialization::IPv4 _netmask;
+            const Object4 _network;
+            const BurpSerialization::PWMLevels _levels;
+            const BurpSerialization::Scalar<uint32_t> _uptime;
+            const BurpSerialization::Scalar<uint16_t> _restarts;
+            const BurpSerialization::Scalar<int32_t> _offset;
+            const BurpSerialization::Scalar<bool> _enabled;
+            const Object4 _counters;
+            const Object4 _root;
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <array>
+#include <vector>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "Bench.hpp"
+#include "Delta.hpp"
+
+namespace Delta {
+
+    constexpr size_t docSize = 512;
+    constexpr size_t iterations = 10000;
+    constexpr size_t sensorCount = 8;
+
+    using Int = BurpSerialization::Scalar<int>;
+    using Sensors = BurpSerialization::Object<sensorCount>;
+
+    // a status document where one reading changes between publishes
+    void run() {
+        static const char * names[sensorCount] = {"s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7"};
+        std::array<Int::Value, sensorCount> values;
+        std::vector<Int> fields;
+        fields.reserve(sensorCount);
+        Sensors::Entries entries;
+        for (size_t index = 0; index < sensorCount; index++) {
+            fields.emplace_back(Int::StatusCodes({0, 0, 1}), values[index]);
+            entries[index] = {names[index], &fields[index]};
+        }
+        bool isNull = false;
+        Sensors sensors(entries, {0, 0, 1}, isNull);
+        BurpSerialization::Serialization serialization(sensors);
+        // a presence byte a slot and each reading
+        BurpSerialization::StaticDelta<1 + sensorCount, 1 + sensorCount * (1 + sizeof(int))> delta;
+        DynamicJsonDocument doc(docSize);
+        size_t fullBytes = 0;
+        size_t deltaBytes = 0;
+        size_t step = 0;
+        Bench::report("Object full serialize", Bench::nsPerOp(iterations, [&]() {
+            values[step++ % sensorCount].value++;
+            doc.clear();
+            serialization.serialize(doc.to<JsonVariant>());
+            fullBytes += measureJson(doc);
+            return doc.memoryUsage();
+        }));
+        Bench::report("Object delta serialize", Bench::nsPerOp(iterations, [&]() {
+            values[step++ % sensorCount].value++;
+            doc.clear();
+            serialization.serializeDelta(doc.to<JsonVariant>(), delta);
+            deltaBytes += measureJson(doc);
+            return doc.memoryUsage();
+        }));
+        printf("%-48s %12u bytes\n", "Object full serialize per publish", static_cast<unsigned>(fullBytes / iterations));
+        printf("%-48s %12u bytes\n", "Object delta serialize per publish", static_cast<unsigned>(deltaBytes / iterations));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/OwnedCStr.hpp"
+#include "../src/BurpSerialization/CStrMap.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "../src/BurpSerialization/CachedIPv4.hpp"
+#include "../src/BurpSerialization/CachedMacAddress.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "Fields.hpp"
+
+namespace Fields {
+
+    constexpr size_t docSize = 16384;
+    constexpr size_t iterations = 200000;
+
+    // Deserialize from an already parsed document and serialize into a
+    // cleared one, so only the field is timed. The bytes are the document
+    // memory for each direction.
+    void measure(const char * name, const BurpSerialization::Field & field, const std::string & json, size_t count = iterations) {
+        DynamicJsonDocument input(docSize);
+        deserializeJson(input, json);
+        std::string label = name;
+        auto ns = Bench::nsPerOp(count, [&]() {
+            return field.deserialize(input.as<JsonVariant>());
+        });
+        Bench::report((label + " deserialize").c_str(), ns, input.memoryUsage());
+        // the field now holds the value to serialize
+        DynamicJsonDocument output(docSize);
+        ns = Bench::nsPerOp(count, [&]() {
+            output.clear();
+            return field.serialize(output.to<JsonVariant>());
+        });
+        Bench::report((label + " serialize").c_str(), ns, output.memoryUsage());
+    }
+
+    template <class Type>
+    void scalar(const char * name, const char * json) {
+        typename BurpSerialization::Scalar<Type>::Value value;
+        BurpSerialization::Scalar<Type> field({0, 1, 2}, value);
+        measure(name, field, json);
+    }
+
+    void cstr(size_t length) {
+        const char * value;
+        BurpSerialization::CStr field(0, length, {0, 1, 2, 3, 4}, value);
+        char name[64];
+        snprintf(name, sizeof(name), "CStr %u chars", static_cast<unsigned>(length));
+        measure(name, field, "\"" + std::string(length, 'x') + "\"");
+    }
+
+    // the copy that lets the document go
+    template <size_t length>
+    void ownedCStr() {
+        typename BurpSerialization::OwnedCStr<length>::Value value;
+        BurpSerialization::OwnedCStr<length> field(0, {0, 1, 2, 3, 4}, value);
+        char name[64];
+        snprintf(name, sizeof(name), "OwnedCStr %u chars", static_cast<unsigned>(length));
+        measure(name, field, "\"" + std::string(length, 'x') + "\"");
+    }
+
+    // the last choice, the worst case for the linear key search
+    template <size_t count>
+    void cstrMap() {
+        using Map = BurpSerialization::CStrMap<uint16_t, count>;
+        std::array<std::array<char, 16>, count> keys;
+        typename Map::Choices choices;
+        for (size_t index = 0; index < count; index++) {
+            snprintf(keys[index].data(), keys[index].size(), "choice%u", static_cast<unsigned>(index));
+            choices[index] = {keys[index].data(), static_cast<uint16_t>(index)};
+        }
+        typename Map::Value value;
+        Map field(choices, {0, 1, 2, 3}, value);
+        char name[64];
+        snprintf(name, sizeof(name), "CStrMap<%u>", static_cast<unsigned>(count));
+        measure(name, field, "\"" + std::string(keys[count - 1].data()) + "\"");
+    }
+
+    template <size_t levelCount = 255>
+    void pwmLevels(size_t count) {
+        using Levels = BurpSerialization::BasicPWMLevels<BurpSerialization::CopiedCodes, levelCount>;
+        typename Levels::Value value;
+        Levels field({0, 1, 2, 3, 4, 5, 6, 7, 8}, value);
+        std::string json = "[";
+        for (size_t index = 0; index < count; index++) {
+            if (index > 0) json += ",";
+            json += std::to_string(index + 1);
+        }
+        json += "]";
+        char name[64];
+        if (levelCount == 255) {
+            snprintf(name, sizeof(name), "PWMLevels %u levels", static_cast<unsigned>(count));
+        } else {
+            snprintf(name, sizeof(name), "PWMLevels<%u> %u levels", static_cast<unsigned>(levelCount), static_cast<unsigned>(count));
+        }
+        measure(name, field, json, iterations / count + 1000);
+    }
+
+    template <size_t entryCount>
+    void object() {
+        using Object = BurpSerialization::Object<entryCount>;
+        std::array<std::array<char, 24>, entryCount> names;
+        std::array<BurpSerialization::Scalar<int>::Value, entryCount> values;
+        std::vector<BurpSerialization::Scalar<int>> fields;
+        fields.reserve(entryCount);
+        typename Object::Entries entries;
+        std::string json = "{";
+        for (size_t index = 0; index < entryCount; index++) {
+            snprintf(names[index].data(), names[index].size(), "configurationKey%u", static_cast<unsigned>(index));
+            fields.emplace_back(BurpSerialization::Scalar<int>::StatusCodes({0, 1, 2}), values[index]);
+            entries[index] = {names[index].data(), &fields[index]};
+            if (index > 0) json += ",";
+            json += "\"" + std::string(names[index].data()) + "\":" + std::to_string(index);
+        }
+        json += "}";
+        bool isNull;
+        Object field(entries, {0, 1, 2}, isNull);
+        char name[64];
+        snprintf(name, sizeof(name), "Object<%u> of Scalar<int>", static_cast<unsigned>(entryCount));
+        measure(name, field, json, iterations / entryCount + 1000);
+    }
+
+    // the whole path from and to text, with the document sized for it
+    void config() {
+        Bench::Config config;
+        std::string json;
+        DynamicJsonDocument doc(docSize);
+        config.root.serialize(doc.to<JsonVariant>());
+        serializeJson(doc, json);
+        measure("Config", config.root, json);
+        auto ns = Bench::nsPerOp(iterations / 10, [&]() {
+            deserializeJson(doc, json);
+            return config.root.deserialize(doc.as<JsonVariant>());
+        });
+        Bench::report("Config from JSON text", ns, doc.memoryUsage());
+        std::string out;
+        ns = Bench::nsPerOp(iterations / 10, [&]() {
+            out.clear();
+            doc.clear();
+            config.root.serialize(doc.to<JsonVariant>());
+            return serializeJson(doc, out);
+        });
+        Bench::report("Config to JSON text", ns, doc.memoryUsage());
+    }
+
+    void run() {
+        scalar<bool>("Scalar<bool>", "true");
+        scalar<uint8_t>("Scalar<uint8_t>", "255");
+        scalar<int32_t>("Scalar<int32_t>", "-2147483648");
+        scalar<uint32_t>("Scalar<uint32_t>", "4294967295");
+        scalar<float>("Scalar<float>", "0.5");
+        cstr(8);
+        cstr(64);
+        ownedCStr<8>();
+        ownedCStr<64>();
+        cstrMap<4>();
+        cstrMap<16>();
+        cstrMap<64>();
+        {
+            BurpSerialization::IPv4::Value value;
+            BurpSerialization::IPv4 field({0, 1, 2, 3, 4, 5, 6}, value);
+            measure("IPv4", field, "\"255.255.255.255\"");
+        }
+        {
+            BurpSerialization::IPv4::Value value;
+            BurpSerialization::IPv4 field({0, 1, 2, 3, 4, 5, 6}, value, BurpSerialization::IPv4Form::integer);
+            measure("IPv4 integer", field, "4294967295");
+        }
+        {
+            BurpSerialization::CachedIPv4::Value value;
+            BurpSerialization::CachedIPv4 field({0, 1, 2, 3, 4, 5, 6}, value);
+            measure("CachedIPv4", field, "\"255.255.255.255\"");
+        }
+        {
+            BurpSerialization::MacAddress::Value value;
+            BurpSerialization::MacAddress field({0, 1, 2, 3, 4, 5, 6, 7}, value);
+            measure("MacAddress", field, "\"ff:ff:ff:ff:ff:ff\"");
+        }
+        {
+            BurpSerialization::MacAddress::Value value;
+            BurpSerialization::MacAddress field({0, 1, 2, 3, 4, 5, 6, 7}, value, BurpSerialization::MacAddressForm::integer);
+            measure("MacAddress integer", field, "281474976710655");
+        }
+        {
+            BurpSerialization::CachedMacAddress::Value value;
+            BurpSerialization::CachedMacAddress field({0, 1, 2, 3, 4, 5, 6, 7}, value);
+            measure("CachedMacAddress", field, "\"ff:ff:ff:ff:ff:ff\"");
+        }
+        pwmLevels(1);
+        pwmLevels(16);
+        pwmLevels(255);
+        pwmLevels<32>(16);
+        printf("%-48s %12u bytes\n", "PWMLevels Value", static_cast<unsigned>(sizeof(BurpSerialization::PWMLevels::Value)));
+        printf("%-48s %12u bytes\n", "PWMLevels<32> Value", static_cast<unsigned>(sizeof(BurpSerialization::BasicPWMLevels<BurpSerialization::CopiedCodes, 32>::Value)));
+        object<4>();
+        object<16>();
+        object<64>();
+        config();
+    }
+
+}
\ No newline at end of file
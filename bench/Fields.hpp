@@ -0,0 +1,7 @@
+#pragma once
+
+namespace Fields {
+
+    void run();
+
+}
\ No newline at end of file
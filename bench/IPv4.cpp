@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <array>
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "Bench.hpp"
+#include "IPv4.hpp"
+
+namespace IPv4 {
+
+    using BurpSerialization::IPv4Text;
+
+    constexpr size_t addressCount = 4096;
+    constexpr size_t iterations = 1000000;
+
+    // The previous implementation: a character at a time with a range
+    // check on every digit, and a modulo based formatter
+    namespace previous {
+
+        IPv4Text parseOctet(const char *& pos, uint32_t & dest) {
+            uint16_t value = 0;
+            auto start = pos;
+            while (*pos >= '0' && *pos <= '9') {
+                value *= 10;
+                value += (*pos) - '0';
+                pos++;
+                if (value > 255) return IPv4Text::outOfRange;
+            }
+            if (pos == start) return IPv4Text::missingField;
+            dest += value;
+            return IPv4Text::ok;
+        }
+
+        IPv4Text parse(const char * src, uint32_t & dest) {
+            dest = 0;
+            auto pos = src;
+            for (uint8_t field = 0; field < BurpSerialization::IPV4_BYTE_COUNT; field++) {
+                dest *= 256;
+                auto result = parseOctet(pos, dest);
+                if (result != IPv4Text::ok) return result;
+                if (field < BurpSerialization::IPV4_BYTE_COUNT - 1) {
+                    if (*pos != '.') return IPv4Text::invalidCharacter;
+                } else {
+                    if (*pos != 0) return IPv4Text::excessCharacters;
+                }
+                pos++;
+            }
+            return IPv4Text::ok;
+        }
+
+        char * formatOctet(uint8_t src, char * dest) {
+            uint8_t ones = src % 10;
+            uint8_t tens = (src - ones) % 100;
+            uint8_t hundreds = src - tens - ones;
+            if (hundreds > 0) {
+                *dest++ = '0' + hundreds / 100;
+                *dest++ = '0' + tens / 10;
+            } else if (tens > 0) {
+                *dest++ = '0' + tens / 10;
+            }
+            *dest = '0' + ones;
+            return dest + 1;
+        }
+
+        char * format(const uint32_t src, char * dest) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                dest = formatOctet(static_cast<uint8_t>(src >> shift), dest);
+                if (shift > 0) *dest++ = '.';
+            }
+            return dest;
+        }
+
+    }
+
+    // device report addresses, mostly private ranges of all lengths
+    std::vector<std::array<char, BurpSerialization::IPV4_MAX_LENGTH + 1>> addresses() {
+        std::vector<std::array<char, BurpSerialization::IPV4_MAX_LENGTH + 1>> text(addressCount);
+        srand(1);
+        for (auto & address : text) {
+            snprintf(address.data(), address.size(), "%u.%u.%u.%u", rand() % 2 ? 10 : 192, rand() & 0xff, rand() & 0xff, rand() & 0xff);
+        }
+        return text;
+    }
+
+    void run() {
+        auto text = addresses();
+        std::vector<uint32_t> values(addressCount);
+        size_t index = 0;
+        Bench::report("IPv4 parse, previous", Bench::nsPerOp(iterations, [&]() {
+            uint32_t value;
+            previous::parse(text[index++ % addressCount].data(), value);
+            return value;
+        }));
+        Bench::report("IPv4 parse", Bench::nsPerOp(iterations, [&]() {
+            auto & value = values[index % addressCount];
+            BurpSerialization::parseIPv4(text[index++ % addressCount].data(), value);
+            return value;
+        }));
+        char buffer[BurpSerialization::IPV4_MAX_LENGTH + 1];
+        Bench::report("IPv4 format, previous", Bench::nsPerOp(iterations, [&]() {
+            return previous::format(values[index++ % addressCount], buffer) - buffer;
+        }));
+        Bench::report("IPv4 format", Bench::nsPerOp(iterations, [&]() {
+            return BurpSerialization::formatIPv4(values[index++ % addressCount], buffer) - buffer;
+        }));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace IPv4 {
+
+    void run();
+
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "../src/BurpSerialization/JsonLines.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "Bench.hpp"
+#include "JsonLines.hpp"
+
+namespace JsonLines {
+
+    constexpr size_t docSize = 512;
+    constexpr size_t recordCount = 10000;
+    constexpr size_t repeats = 20;
+    constexpr size_t threadCount = 4;
+
+    using Int = BurpSerialization::Scalar<int>;
+    using Object = BurpSerialization::Object<4>;
+
+    struct Record {
+        bool isNull;
+        const char * name;
+        Int::Value count;
+        Int::Value level;
+        BurpSerialization::IPv4::Value address;
+    };
+
+    // a queue dump of device reports, one per line
+    class Decoder : public BurpSerialization::Serialization {
+
+        public:
+
+            Record scratch;
+            DynamicJsonDocument doc;
+            BurpSerialization::JsonLines<Record> lines;
+
+            Decoder() :
+                BurpSerialization::Serialization(_obj),
+                doc(docSize),
+                lines(*this, scratch, doc, {0, 1, 2}),
+                _name(1, 32, {0, 1, 2, 3, 4}, scratch.name),
+                _count({0, 1, 2}, scratch.count),
+                _level({0, 1, 2}, scratch.level),
+                _address({0, 1, 2, 3, 4, 5, 6}, scratch.address),
+                _obj({
+                    Object::Entry({"name", &_name}),
+                    Object::Entry({"count", &_count}),
+                    Object::Entry({"level", &_level}),
+                    Object::Entry({"address", &_address})
+                }, {0, 1, 2}, scratch.isNull)
+            {}
+
+        private:
+
+            const BurpSerialization::CStr _name;
+            const Int _count;
+            const Int _level;
+            const BurpSerialization::IPv4 _address;
+            const Object _obj;
+
+    };
+
+    std::string input() {
+        std::string text;
+        char line[128];
+        for (size_t index = 0; index < recordCount; index++) {
+            snprintf(line, sizeof(line), "{\"name\":\"device-%u\",\"count\":%u,\"level\":%u,\"address\":\"10.0.%u.%u\"}\n",
+                static_cast<unsigned>(index), static_cast<unsigned>(index * 7), static_cast<unsigned>(index % 100),
+                static_cast<unsigned>(index / 256 % 256), static_cast<unsigned>(index % 256));
+            text += line;
+        }
+        return text;
+    }
+
+    void report(const char * name, const double nsPerBatch) {
+        auto nsPerRecord = nsPerBatch / recordCount;
+        Bench::report(name, nsPerRecord);
+        printf("%-48s %12.0f records/s\n", name, 1e9 / nsPerRecord);
+    }
+
+    void run() {
+        auto text = input();
+        std::vector<char> buffer(text.size());
+        std::vector<Record> records(recordCount);
+        std::vector<BurpStatus::Status::Code> codes(recordCount);
+        Decoder decoder;
+        // The previous way: a document per line, parsed from read only
+        // input so the strings are copied into it
+        report("JsonLines, document per line", Bench::nsPerOp(repeats, [&]() {
+            size_t count = 0;
+            auto pos = text.c_str();
+            auto end = pos + text.size();
+            while (pos < end) {
+                auto newline = static_cast<const char *>(memchr(pos, '\n', end - pos));
+                DynamicJsonDocument doc(docSize);
+                deserializeJson(doc, pos, newline - pos);
+                codes[count] = decoder.deserialize(doc.as<JsonVariant>());
+                records[count++] = decoder.scratch;
+                pos = newline + 1;
+            }
+            return count;
+        }));
+        // each batch parses a fresh copy, as parsing in place changes it
+        report("JsonLines, one decoder", Bench::nsPerOp(repeats, [&]() {
+            memcpy(buffer.data(), text.data(), text.size());
+            return decoder.lines.decode(buffer.data(), buffer.size(), records.data(), codes.data(), recordCount);
+        }));
+        std::vector<Decoder> decoders(threadCount);
+        BurpSerialization::JsonLinesWorkers<Record>::Decoders lines;
+        for (auto & each : decoders) {
+            lines.push_back(&each.lines);
+        }
+        // the workers are started once, outside the timing
+        BurpSerialization::JsonLinesWorkers<Record> workers(lines);
+        char name[64];
+        snprintf(name, sizeof(name), "JsonLines, %u threads", static_cast<unsigned>(threadCount));
+        report(name, Bench::nsPerOp(repeats, [&]() {
+            memcpy(buffer.data(), text.data(), text.size());
+            return workers.decode(buffer.data(), buffer.size(), records.data(), codes.data(), recordCount);
+        }));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace JsonLines {
+
+    void run();
+
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <array>
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "Bench.hpp"
+#include "MacAddress.hpp"
+
+namespace MacAddress {
+
+    using BurpSerialization::MacAddressText;
+    using BurpSerialization::MAC_ADDRESS_BYTE_COUNT;
+    using BurpSerialization::MAC_ADDRESS_LENGTH;
+
+    constexpr size_t addressCount = 4096;
+    constexpr size_t iterations = 1000000;
+
+    using Bytes = std::array<uint8_t, MAC_ADDRESS_BYTE_COUNT>;
+
+    // The previous implementation: a branch per nibble and a modulo
+    // based formatter
+    namespace previous {
+
+        char hexDigit(uint8_t value) {
+            if (value < 10) {
+                return '0' + value;
+            }
+            return 'A' + (value - 10);
+        }
+
+        int8_t hexValue(char digit) {
+            if (digit >= '0' && digit <= '9') {
+                return digit - '0';
+            }
+            if (digit >= 'a' && digit <= 'f') {
+                return 10 + digit - 'a';
+            }
+            if (digit >= 'A' && digit <= 'F') {
+                return 10 + digit - 'A';
+            }
+            return -1;
+        }
+
+        char * uint8ToHex(uint8_t src, char * dest) {
+            uint8_t ones = src % 0x10;
+            uint8_t sixteens = src - ones;
+            *dest = hexDigit(sixteens / 0x10);
+            dest++;
+            *dest = hexDigit(ones);
+            dest++;
+            return dest;
+        }
+
+        char * format(const uint8_t src[MAC_ADDRESS_BYTE_COUNT], char * dest) {
+            char * pos = dest;
+            for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
+                if (field > 0) {
+                    *pos = ':';
+                    pos++;
+                }
+                pos = uint8ToHex(src[field], pos);
+            }
+            return pos;
+        }
+
+        MacAddressText parseByte(const char *& pos, uint8_t & dest) {
+            uint16_t value = 0;
+            auto start = pos;
+            int8_t digit = hexValue(*pos);
+            while (digit > -1) {
+                value *= 0x10;
+                value += digit;
+                pos++;
+                digit = hexValue(*pos);
+                if (value > 255) return MacAddressText::outOfRange;
+            }
+            if (pos == start) return MacAddressText::missingField;
+            dest = value;
+            return MacAddressText::ok;
+        }
+
+        MacAddressText parse(const char * src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT]) {
+            auto pos = src;
+            char separator = ':';
+            for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
+                auto result = parseByte(pos, dest[field]);
+                if (result != MacAddressText::ok) return result;
+                if (field == 0) {
+                    if (*pos == ':') separator = ':';
+                    else if (*pos == '-') separator = '-';
+                    else return MacAddressText::invalidCharacter;
+                }
+                else if (field < MAC_ADDRESS_BYTE_COUNT - 1) {
+                    if (*pos != separator) return MacAddressText::invalidSeparator;
+                } else {
+                    if (*pos != 0) return MacAddressText::excessCharacters;
+                }
+                pos++;
+            }
+            return MacAddressText::ok;
+        }
+
+    }
+
+    // inventory records, canonical with either case and separator
+    std::vector<std::array<char, MAC_ADDRESS_LENGTH + 1>> addresses() {
+        std::vector<std::array<char, MAC_ADDRESS_LENGTH + 1>> text(addressCount);
+        srand(1);
+        for (auto & address : text) {
+            auto format = rand() % 2 ? "%02X:%02X:%02X:%02X:%02X:%02X" : "%02x-%02x-%02x-%02x-%02x-%02x";
+            snprintf(address.data(), address.size(), format, rand() & 0xff, rand() & 0xff, rand() & 0xff, rand() & 0xff, rand() & 0xff, rand() & 0xff);
+        }
+        return text;
+    }
+
+    void run() {
+        auto text = addresses();
+        std::vector<Bytes> values(addressCount);
+        size_t index = 0;
+        Bench::report("MacAddress parse, previous", Bench::nsPerOp(iterations, [&]() {
+            Bytes value;
+            previous::parse(text[index++ % addressCount].data(), value.data());
+            return value[0];
+        }));
+        Bench::report("MacAddress parse", Bench::nsPerOp(iterations, [&]() {
+            auto & value = values[index % addressCount];
+            BurpSerialization::parseMacAddress(text[index++ % addressCount].data(), value.data());
+            return value[0];
+        }));
+        char buffer[MAC_ADDRESS_LENGTH + 1];
+        Bench::report("MacAddress format, previous", Bench::nsPerOp(iterations, [&]() {
+            return previous::format(values[index++ % addressCount].data(), buffer) - buffer;
+        }));
+        Bench::report("MacAddress format", Bench::nsPerOp(iterations, [&]() {
+            return BurpSerialization::formatMacAddress(values[index++ % addressCount].data(), buffer) - buffer;
+        }));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include "../src/BurpSerialization/Parser.hpp"
+#include "../src/BurpSerialization/MsgPackParser.hpp"
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "MsgPack.hpp"
+
+namespace MsgPack {
+
+    constexpr size_t bufferSize = 1024;
+    constexpr size_t iterations = 100000;
+
+    size_t write(const Bench::Config & config, char * buffer, const BurpSerialization::Writer::Format format) {
+        BurpSerialization::Writer writer(buffer, bufferSize, format);
+        config.root.write(writer);
+        return writer.length();
+    }
+
+    void run() {
+        Bench::Config config;
+        char json[bufferSize];
+        char msgPack[bufferSize];
+        char strings[bufferSize];
+        auto jsonLength = write(config, json, BurpSerialization::Writer::Format::json);
+        auto msgPackLength = write(config, msgPack, BurpSerialization::Writer::Format::msgPack);
+        printf("%-48s %12u bytes\n", "config as JSON", static_cast<unsigned>(jsonLength));
+        printf("%-48s %12u bytes\n", "config as MessagePack", static_cast<unsigned>(msgPackLength));
+
+        Bench::report("config write JSON", Bench::nsPerOp(iterations, [&]() {
+            return write(config, json, BurpSerialization::Writer::Format::json);
+        }));
+        Bench::report("config write MessagePack", Bench::nsPerOp(iterations, [&]() {
+            return write(config, msgPack, BurpSerialization::Writer::Format::msgPack);
+        }));
+
+        BurpSerialization::Parser jsonParser(config.root, strings, bufferSize, {0, 1, 2, 3, 4});
+        Bench::report("config Parser JSON", Bench::nsPerOp(iterations, [&]() {
+            jsonParser.begin();
+            jsonParser.write(json, jsonLength);
+            return jsonParser.end();
+        }));
+        BurpSerialization::MsgPackParser msgPackParser(config.root, strings, bufferSize, {0, 1, 2, 3, 4});
+        Bench::report("config MsgPackParser MessagePack", Bench::nsPerOp(iterations, [&]() {
+            msgPackParser.begin();
+            msgPackParser.write(reinterpret_cast<const uint8_t *>(msgPack), msgPackLength);
+            return msgPackParser.end();
+        }));
+    }
+
+}
\ No newline at end of file
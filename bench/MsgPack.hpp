@@ -0,0 +1,7 @@
+#pragma once
+
+namespace MsgPack {
+
+    void run();
+
+}
\ No newline at end of file
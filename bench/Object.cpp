@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <vector>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "Bench.hpp"
+#include "Object.hpp"
+
+namespace Object {
+
+    // Trivial leaf so that the timings are dominated by key matching
+    class IntField : public BurpSerialization::Field {
+
+        public:
+
+            mutable int value = 0;
+
+            BurpStatus::Status::Code deserialize(const JsonVariant & src) const override {
+                value = src.as<int>();
+                return 0;
+            }
+
+            bool serialize(const JsonVariant & dest) const override {
+                return dest.set(value);
+            }
+
+    };
+
+    template <size_t entryCount>
+    class Fixture {
+
+        public:
+
+            using Object = BurpSerialization::Object<entryCount>;
+
+            Fixture() :
+                _entries(_makeEntries()),
+                _object(_entries, {0, 1, 2}, _isNull),
+                _inOrder(JSON_OBJECT_SIZE(entryCount)),
+                _reversed(JSON_OBJECT_SIZE(entryCount))
+            {
+                auto inOrder = _inOrder.to<JsonObject>();
+                auto reversed = _reversed.to<JsonObject>();
+                for (size_t index = 0; index < entryCount; index++) {
+                    inOrder[_entries[index].name] = index;
+                    reversed[_entries[entryCount - index - 1].name] = index;
+                }
+            }
+
+            void run() {
+                char name[64];
+                auto iterations = 1000000 / entryCount;
+                snprintf(name, sizeof(name), "Object<%u> linear, in order", static_cast<unsigned>(entryCount));
+                Bench::report(name, Bench::nsPerOp(iterations, [&]() {
+                    return _linear(_inOrder.as<JsonVariant>());
+                }));
+                snprintf(name, sizeof(name), "Object<%u> linear, reversed", static_cast<unsigned>(entryCount));
+                Bench::report(name, Bench::nsPerOp(iterations, [&]() {
+                    return _linear(_reversed.as<JsonVariant>());
+                }));
+                snprintf(name, sizeof(name), "Object<%u> indexed, in order", static_cast<unsigned>(entryCount));
+                Bench::report(name, Bench::nsPerOp(iterations, [&]() {
+                    return _object.deserialize(_inOrder.as<JsonVariant>());
+                }));
+                snprintf(name, sizeof(name), "Object<%u> indexed, reversed", static_cast<unsigned>(entryCount));
+                Bench::report(name, Bench::nsPerOp(iterations, [&]() {
+                    return _object.deserialize(_reversed.as<JsonVariant>());
+                }));
+            }
+
+        private:
+
+            std::array<std::array<char, 24>, entryCount> _names;
+            std::array<IntField, entryCount> _fields;
+            const typename Object::Entries _entries;
+            bool _isNull;
+            const Object _object;
+            DynamicJsonDocument _inOrder;
+            DynamicJsonDocument _reversed;
+
+            typename Object::Entries _makeEntries() {
+                typename Object::Entries entries;
+                for (size_t index = 0; index < entryCount; index++) {
+                    // shared prefixes, as in real configs, make strcmp work for it
+                    snprintf(_names[index].data(), _names[index].size(), "configurationKey%u", static_cast<unsigned>(index));
+                    entries[index] = {_names[index].data(), &_fields[index]};
+                }
+                return entries;
+            }
+
+            // The previous implementation: one member lookup per entry
+            BurpStatus::Status::Code _linear(const JsonVariant & serialized) const {
+                BurpStatus::Status::Code ret = 0;
+                for (auto & entry : _entries) {
+                    ret += entry.field->deserialize(serialized[entry.name]);
+                }
+                return ret;
+            }
+
+    };
+
+    // A gateway workload where 9 in 10 messages have a bad first member
+    void rejects() {
+        constexpr size_t entryCount = 16;
+        constexpr size_t messageCount = 10;
+        using Int = BurpSerialization::Scalar<int>;
+        using Object = BurpSerialization::Object<entryCount>;
+        std::array<std::array<char, 24>, entryCount> names;
+        std::array<Int::Value, entryCount> values;
+        std::vector<Int> fields;
+        fields.reserve(entryCount);
+        Object::Entries entries;
+        for (size_t index = 0; index < entryCount; index++) {
+            snprintf(names[index].data(), names[index].size(), "configurationKey%u", static_cast<unsigned>(index));
+            fields.emplace_back(Int::StatusCodes({0, 1, 2}), values[index]);
+            entries[index] = {names[index].data(), &fields[index]};
+        }
+        bool isNull;
+        Object object(entries, {0, 1, 2}, isNull);
+        DynamicJsonDocument doc(JSON_ARRAY_SIZE(messageCount) + messageCount * JSON_OBJECT_SIZE(entryCount));
+        auto messages = doc.to<JsonArray>();
+        for (size_t message = 0; message < messageCount; message++) {
+            auto members = messages.createNestedObject();
+            for (size_t index = 0; index < entryCount; index++) {
+                if (index == 0 && message > 0) {
+                    members[entries[index].name] = "bad";
+                } else {
+                    members[entries[index].name] = index;
+                }
+            }
+        }
+        BurpSerialization::Serialization collectAll(object);
+        BurpSerialization::Serialization failFast(object, BurpSerialization::Serialization::Mode::failFast);
+        size_t step = 0;
+        Bench::report("Object<16> 90% rejects, collect all", Bench::nsPerOp(100000, [&]() {
+            return collectAll.deserialize(messages[step++ % messageCount]);
+        }));
+        Bench::report("Object<16> 90% rejects, fail fast", Bench::nsPerOp(100000, [&]() {
+            return failFast.deserialize(messages[step++ % messageCount]);
+        }));
+    }
+
+    void run() {
+        rejects();
+        Fixture<4>().run();
+        Fixture<16>().run();
+        Fixture<40>().run();
+        Fixture<64>().run();
+    }
+
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace Object {
+
+    void run();
+
+}
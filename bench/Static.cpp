@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/StaticObject.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "Bench.hpp"
+#include "Static.hpp"
+
+namespace Static {
+
+    constexpr size_t entryCount = 8;
+    constexpr size_t docSize = 1024;
+    constexpr size_t bufferSize = 256;
+    constexpr size_t iterations = 200000;
+
+    using Int = BurpSerialization::Scalar<int>;
+    using Virtual = BurpSerialization::Object<entryCount>;
+    using Static = BurpSerialization::StaticObject<Int, Int, Int, Int, Int, Int, Int, Int>;
+
+    const char * names[entryCount] = {"one", "two", "three", "four", "five", "six", "seven", "eight"};
+
+    // the same schema built both ways over the same fields
+    struct Fixture {
+
+        std::array<Int::Value, entryCount> values;
+        bool isNull;
+        const std::array<Int, entryCount> fields;
+        const Virtual virtualObject;
+        const Static staticObject;
+
+        Fixture() :
+            fields({
+                Int({0, 1, 2}, values[0]), Int({0, 1, 2}, values[1]),
+                Int({0, 1, 2}, values[2]), Int({0, 1, 2}, values[3]),
+                Int({0, 1, 2}, values[4]), Int({0, 1, 2}, values[5]),
+                Int({0, 1, 2}, values[6]), Int({0, 1, 2}, values[7])
+            }),
+            virtualObject({
+                Virtual::Entry({names[0], &fields[0]}), Virtual::Entry({names[1], &fields[1]}),
+                Virtual::Entry({names[2], &fields[2]}), Virtual::Entry({names[3], &fields[3]}),
+                Virtual::Entry({names[4], &fields[4]}), Virtual::Entry({names[5], &fields[5]}),
+                Virtual::Entry({names[6], &fields[6]}), Virtual::Entry({names[7], &fields[7]})
+            }, {0, 1, 2}, isNull),
+            staticObject(
+                {names[0], names[1], names[2], names[3], names[4], names[5], names[6], names[7]},
+                Static::Members(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7]),
+                {0, 1, 2},
+                isNull
+            )
+        {}
+
+    };
+
+    void run() {
+        Fixture fixture;
+        DynamicJsonDocument input(docSize);
+        DynamicJsonDocument output(docSize);
+        char buffer[bufferSize];
+        auto object = input.to<JsonObject>();
+        for (size_t index = 0; index < entryCount; index++) {
+            object[names[index]] = index;
+        }
+
+        printf("%-48s %12u bytes\n", "Object<8> of Scalar<int>", static_cast<unsigned>(sizeof(Virtual)));
+        printf("%-48s %12u bytes\n", "StaticObject of 8 Scalar<int>", static_cast<unsigned>(sizeof(Static)));
+
+        Bench::report("Object<8> virtual deserialize", Bench::nsPerOp(iterations, [&]() {
+            return fixture.virtualObject.deserialize(input.as<JsonVariant>());
+        }));
+        // a qualified call, as StaticSerialization makes
+        Bench::report("Object<8> static deserialize", Bench::nsPerOp(iterations, [&]() {
+            return fixture.staticObject.Static::deserialize(input.as<JsonVariant>());
+        }));
+        Bench::report("Object<8> virtual serialize", Bench::nsPerOp(iterations, [&]() {
+            output.clear();
+            return fixture.virtualObject.serialize(output.to<JsonVariant>());
+        }));
+        Bench::report("Object<8> static serialize", Bench::nsPerOp(iterations, [&]() {
+            output.clear();
+            return fixture.staticObject.Static::serialize(output.to<JsonVariant>());
+        }));
+        Bench::report("Object<8> virtual write", Bench::nsPerOp(iterations, [&]() {
+            BurpSerialization::Writer writer(buffer, bufferSize);
+            fixture.virtualObject.write(writer);
+            return writer.length();
+        }));
+        Bench::report("Object<8> static write", Bench::nsPerOp(iterations, [&]() {
+            BurpSerialization::Writer writer(buffer, bufferSize);
+            fixture.staticObject.Static::write(writer);
+            return writer.length();
+        }));
+    }
+
+}
\ No newline at end of file
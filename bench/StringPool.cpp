@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/StringPool.hpp"
+#include "Bench.hpp"
+#include "StringPool.hpp"
+
+namespace StringPool {
+
+    constexpr size_t docSize = 256;
+    constexpr size_t recordCount = 1000;
+    constexpr size_t nameCount = 16;
+
+    // records whose names repeat, as device and zone labels do
+    std::vector<std::string> records() {
+        std::vector<std::string> json;
+        for (size_t index = 0; index < recordCount; index++) {
+            json.push_back("\"zone label " + std::to_string(index % nameCount) + "\"");
+        }
+        return json;
+    }
+
+    double deserializeAll(const BurpSerialization::CStr & field, const std::vector<std::string> & json) {
+        DynamicJsonDocument doc(docSize);
+        size_t index = 0;
+        return Bench::nsPerOp(json.size(), [&]() {
+            deserializeJson(doc, json[index++]);
+            return field.deserialize(doc.as<JsonVariant>());
+        });
+    }
+
+    void run() {
+        auto json = records();
+        const char * value;
+        BurpSerialization::CStr plain(0, 32, {0, 1, 2, 3, 4}, value);
+        Bench::report("CStr record deserialize", deserializeAll(plain, json));
+        BurpSerialization::StaticStringPool<1024, 64> pool;
+        BurpSerialization::CStr interned(0, 32, {0, 1, 2, 3, 4}, value, &pool);
+        Bench::report("CStr interned record deserialize", deserializeAll(interned, json));
+        auto & stats = pool.stats();
+        printf("%-48s %11.1f%%\n", "StringPool hit rate", 100.0 * stats.hits / stats.lookups);
+        printf("%-48s %12u bytes\n", "StringPool bytes used", static_cast<unsigned>(stats.bytesUsed));
+        printf("%-48s %12u bytes\n", "StringPool bytes saved", static_cast<unsigned>(stats.bytesSaved));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.hpp"
+#include "CStrMap.hpp"
+#include "Object.hpp"
+#include "MsgPack.hpp"
+#include "Binary.hpp"
+#include "Fields.hpp"
+#include "Static.hpp"
+#include "Codes.hpp"
+#include "StringPool.hpp"
+#include "Delta.hpp"
+#include "IPv4.hpp"
+#include "MacAddress.hpp"
+#include "JsonLines.hpp"
+
+// options:
+//   --save <path>       write the results as JSON, to keep as a baseline
+//   --baseline <path>   compare with a saved baseline, exit 1 on a regression
+//   --threshold <ratio> allowed slowdown before a regression, default 0.1
+int main(int argc, char ** argv) {
+    const char * savePath = nullptr;
+    const char * baselinePath = nullptr;
+    double threshold = 0.1;
+    for (int index = 1; index < argc; index += 2) {
+        if (index + 1 == argc) {
+            printf("missing value for %s\n", argv[index]);
+            return 2;
+        }
+        if (strcmp(argv[index], "--save") == 0) {
+            savePath = argv[index + 1];
+        } else if (strcmp(argv[index], "--baseline") == 0) {
+            baselinePath = argv[index + 1];
+        } else if (strcmp(argv[index], "--threshold") == 0) {
+            threshold = atof(argv[index + 1]);
+        } else {
+            printf("unknown option %s\n", argv[index]);
+            return 2;
+        }
+    }
+
+    Fields::run();
+    CStrMap::run();
+    Object::run();
+    MsgPack::run();
+    Binary::run();
+    Static::run();
+    Codes::run();
+    StringPool::run();
+    Delta::run();
+    IPv4::run();
+    MacAddress::run();
+    JsonLines::run();
+
+    if (savePath != nullptr && !Bench::save(savePath)) return 2;
+    if (baselinePath != nullptr && !Bench::compare(baselinePath, threshold)) return 1;
+    return 0;
+}
\ No newline at end of file
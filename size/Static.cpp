@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <array>
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/StaticObject.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+
+// The schema of bench/Static.cpp built one way only, as Object<8> or with
+// BURP_SIZE_STATIC as a StaticObject, so that `size` on each firmware
+// compares them. It reads a JSON object, deserializes and writes it back
+// so that nothing is folded away.
+
+namespace {
+
+    constexpr size_t entryCount = 8;
+    constexpr size_t docSize = 512;
+    constexpr size_t bufferSize = 256;
+
+    using Int = BurpSerialization::Scalar<int>;
+#ifdef BURP_SIZE_STATIC
+    using Schema = BurpSerialization::StaticObject<Int, Int, Int, Int, Int, Int, Int, Int>;
+#else
+    using Schema = BurpSerialization::Object<entryCount>;
+#endif
+
+    const char * names[entryCount] = {"one", "two", "three", "four", "five", "six", "seven", "eight"};
+
+    std::array<Int::Value, entryCount> values;
+    bool isNull;
+    const std::array<Int, entryCount> fields = {{
+        Int({0, 1, 2}, values[0]), Int({0, 1, 2}, values[1]),
+        Int({0, 1, 2}, values[2]), Int({0, 1, 2}, values[3]),
+        Int({0, 1, 2}, values[4]), Int({0, 1, 2}, values[5]),
+        Int({0, 1, 2}, values[6]), Int({0, 1, 2}, values[7])
+    }};
+#ifdef BURP_SIZE_STATIC
+    const Schema schema(
+        {names[0], names[1], names[2], names[3], names[4], names[5], names[6], names[7]},
+        Schema::Members(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7]),
+        {0, 1, 2},
+        isNull
+    );
+#else
+    const Schema schema({
+        Schema::Entry({names[0], &fields[0]}), Schema::Entry({names[1], &fields[1]}),
+        Schema::Entry({names[2], &fields[2]}), Schema::Entry({names[3], &fields[3]}),
+        Schema::Entry({names[4], &fields[4]}), Schema::Entry({names[5], &fields[5]}),
+        Schema::Entry({names[6], &fields[6]}), Schema::Entry({names[7], &fields[7]})
+    }, {0, 1, 2}, isNull);
+#endif
+
+    // qualified calls, as StaticSerialization makes
+    size_t roundTrip(const char * json, char * buffer) {
+        StaticJsonDocument<docSize> doc;
+        if (deserializeJson(doc, json)) return 0;
+        if (schema.Schema::deserialize(doc.as<JsonVariant>()) != 0) return 0;
+        BurpSerialization::Writer writer(buffer, bufferSize);
+        if (!schema.Schema::write(writer)) return 0;
+        return writer.length();
+    }
+
+}
+
+#ifdef BURP_NATIVE
+
+int main() {
+    char json[bufferSize];
+    char buffer[bufferSize];
+    if (!fgets(json, bufferSize, stdin)) return 1;
+    if (roundTrip(json, buffer) == 0) return 1;
+    puts(buffer);
+    return 0;
+}
+
+#else
+
+void setup() {
+    Serial.begin(115200);
+}
+
+void loop() {
+    char json[bufferSize];
+    char buffer[bufferSize];
+    auto length = Serial.readBytesUntil('\n', json, bufferSize - 1);
+    if (length == 0) return;
+    json[length] = 0;
+    if (roundTrip(json, buffer) == 0) return;
+    Serial.println(buffer);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <array>
+#include "Field.hpp"
+#include "Codes.hpp"
+
+namespace BurpSerialization
+{
+
+    // A JSON array of up to maxLength elements of one field type, held
+    // contiguously in the Value with a length. A single element field,
+    // bound to a scratch ElementValue, reads and writes every element:
+    // Array copies each element into the scratch value before serializing
+    // it and out of it after deserializing it. Element failures return
+    // the element's own code.
+    //
+    //     using Addresses = Array<IPv4, 4>;
+    //     IPv4::Value address;
+    //     IPv4 addressField({...}, address);
+    //     Addresses addresses(1, {...}, addressField, address, value);
+    //
+    // For Objects, ElementValue is the struct the Object's members are
+    // bound to. Elements whose serialize links text in the field or the
+    // scratch value, such as OwnedCStr and CachedIPv4 (see LinksText),
+    // would all read the last element, so serialize copies their text
+    // into the document: size it with the capacity of a copying element,
+    // as in Array<CachedIPv4, 4>::capacity(IPv4::capacity()).
+    template <class Element, size_t maxLength, template <class> class Codes = CopiedCodes, class ElementValue = typename Element::Value>
+    class Array : public Field
+    {
+
+    public:
+
+        struct Value {
+            bool isNull = false;
+            std::array<ElementValue, maxLength> list;
+            size_t length = 0;
+        };
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code notPresent; // set to ok if not required
+            const BurpStatus::Status::Code wrongType;
+            const BurpStatus::Status::Code tooShort;
+            const BurpStatus::Status::Code tooLong;
+        };
+
+        // the capacity of one element
+        static constexpr Capacity capacity(const Capacity element) {
+            return {
+                JSON_ARRAY_SIZE(maxLength) + element.pool * maxLength,
+                element.inStrings * maxLength,
+                element.outStrings * maxLength
+            };
+        }
+
+        Array(const size_t minLength, typename Codes<StatusCodes>::Argument statusCodes, const Element & element, ElementValue & elementValue, Value & value) :
+            _minLength(minLength),
+            _statusCodes(statusCodes),
+            _element(element),
+            _elementValue(elementValue),
+            _value(value)
+        {}
+
+        BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override {
+            return _deserialize(serialized, false);
+        }
+
+        BurpStatus::Status::Code deserializeFailFast(const JsonVariant & serialized) const override {
+            return _deserialize(serialized, true);
+        }
+
+        bool serialize(const JsonVariant & serialized) const override {
+            if (_value.isNull) {
+                serialized.clear();
+                return true;
+            }
+            auto jsonArray = serialized.to<JsonArray>();
+            for (size_t index = 0; index < _value.length; index++) {
+                auto element = jsonArray.addElement();
+                _elementValue = _value.list[index];
+                if (!_element.Element::serialize(element)) return false;
+                if (!_keep(element, LinksText<Element>())) return false;
+            }
+            return true;
+        }
+
+        bool write(Writer & writer) const override {
+            if (_value.isNull) {
+                return writer.null();
+            }
+            if (!writer.beginArray(_value.length)) return false;
+            for (size_t index = 0; index < _value.length; index++) {
+                _elementValue = _value.list[index];
+                if (!_element.Element::write(writer)) return false;
+            }
+            return writer.endArray();
+        }
+
+        bool isNull() const override {
+            return _value.isNull;
+        }
+
+        // a length, a bitmap of the elements that are not null, then each
+        // of those elements
+        bool encode(BinaryEncoder & encoder) const override {
+            if (!encoder.lengthPrefix(_value.length)) return false;
+            std::array<uint8_t, bitmapSize> bitmap = {};
+            for (size_t index = 0; index < _value.length; index++) {
+                _elementValue = _value.list[index];
+                if (!_element.Element::isNull()) bitmap[index / 8] |= 1 << (index % 8);
+            }
+            auto size = (_value.length + 7) / 8;
+            if (encoder.write(bitmap.data(), size) != size) return false;
+            for (size_t index = 0; index < _value.length; index++) {
+                if (!_isPresent(bitmap.data(), index)) continue;
+                _elementValue = _value.list[index];
+                if (!_element.Element::encode(encoder)) return false;
+            }
+            return true;
+        }
+
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override {
+            size_t length;
+            const uint8_t * bitmap = nullptr;
+            if (decoder.lengthPrefix(length)) bitmap = decoder.read((length + 7) / 8);
+            if (bitmap == nullptr) return deserialize(JsonVariant());
+            // elements past maxLength are still decoded, into the scratch
+            // value, so that the fields after the array line up
+            beginArray();
+            for (size_t index = 0; index < length; index++) {
+                auto code = _isPresent(bitmap, index) ? _element.Element::decode(decoder) : _element.Element::deserialize(JsonVariant());
+                childDeserialized(code);
+            }
+            return endContainer();
+        }
+
+        uint32_t fingerprint(uint32_t hash) const override {
+            const uint8_t length[] = {
+                static_cast<uint8_t>(maxLength),
+                static_cast<uint8_t>(maxLength >> 8),
+                static_cast<uint8_t>(maxLength >> 16),
+                static_cast<uint8_t>(maxLength >> 24)
+            };
+            hash = hashBytes(length, sizeof(length), hashKey("[", hash));
+            return hashKey("]", _element.Element::fingerprint(hash));
+        }
+
+        bool beginArray() const override {
+            _value.isNull = true;
+            _count = 0;
+            _code = _statusCodes.get(&StatusCodes::ok);
+            return true;
+        }
+
+        const Field * element() const override {
+            return &_element;
+        }
+
+        void childDeserialized(const BurpStatus::Status::Code code) const override {
+            auto index = _count++;
+            // keep counting past the first error so that tooLong still wins
+            if (index >= maxLength || _code != _statusCodes.get(&StatusCodes::ok)) return;
+            if (code != _statusCodes.get(&StatusCodes::ok)) {
+                _code = code;
+                return;
+            }
+            _value.list[index] = _elementValue;
+        }
+
+        BurpStatus::Status::Code endContainer() const override {
+            if (_count > maxLength) {
+                return _statusCodes.get(&StatusCodes::tooLong);
+            }
+            if (_count < _minLength) {
+                return _statusCodes.get(&StatusCodes::tooShort);
+            }
+            if (_code != _statusCodes.get(&StatusCodes::ok)) {
+                return _code;
+            }
+            _value.isNull = false;
+            _value.length = _count;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+
+    private:
+
+        static constexpr size_t bitmapSize = (maxLength + 7) / 8;
+
+        const size_t _minLength;
+        const Codes<StatusCodes> _statusCodes;
+        const Element & _element;
+        ElementValue & _elementValue;
+        Value & _value;
+
+        // element by element deserialization state
+        mutable size_t _count;
+        mutable BurpStatus::Status::Code _code;
+
+        BurpStatus::Status::Code _deserialize(const JsonVariant & serialized, const bool failFast) const {
+            _value.isNull = true;
+            if (serialized.isNull()) {
+                return _statusCodes.get(&StatusCodes::notPresent);
+            }
+            if (serialized.is<JsonArray>()) {
+                auto jsonArray = serialized.as<JsonArray>();
+                if (jsonArray.size() > maxLength) {
+                    return _statusCodes.get(&StatusCodes::tooLong);
+                }
+                beginArray();
+                for (auto element : jsonArray) {
+                    auto code = failFast ? _element.Element::deserializeFailFast(element) : _element.Element::deserialize(element);
+                    childDeserialized(code);
+                    if (failFast && _code != _statusCodes.get(&StatusCodes::ok)) return _code;
+                }
+                return endContainer();
+            }
+            return _statusCodes.get(&StatusCodes::wrongType);
+        }
+
+        // the next element reuses the linked text, so the document takes a copy
+        static bool _keep(const JsonVariant & element, std::true_type) {
+            if (!element.is<const char *>()) return true;
+            return element.set(const_cast<char *>(element.as<const char *>()));
+        }
+
+        static bool _keep(const JsonVariant &, std::false_type) {
+            return true;
+        }
+
+        static bool _isPresent(const uint8_t * bitmap, const size_t index) {
+            return (bitmap[index / 8] >> (index % 8)) & 1;
+        }
+
+    };
+
+}
\ No newline at end of file
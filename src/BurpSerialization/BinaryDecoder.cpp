@@ -0,0 +1,107 @@
+#include <string.h>
+#include "BinaryDecoder.hpp"
+#include "Field.hpp"
+
+namespace BurpSerialization
+{
+
+    BinaryDecoder::BinaryDecoder(char * buffer, const size_t size, const StatusCodes statusCodes) :
+        _buffer(buffer),
+        _size(size),
+        _statusCodes(statusCodes),
+        _data(nullptr),
+        _length(0),
+        _position(0),
+        _used(0),
+        _error(statusCodes.ok),
+        _schema(nullptr),
+        _fingerprint(0)
+    {}
+
+    uint32_t BinaryDecoder::_fingerprintOf(const Field & root) {
+        if (_schema != &root) {
+            _schema = &root;
+            _fingerprint = root.fingerprint(hashSeed);
+        }
+        return _fingerprint;
+    }
+
+    BurpStatus::Status::Code BinaryDecoder::decode(const Field & root, const uint8_t * data, const size_t length) {
+        _data = data;
+        _length = length;
+        _position = 0;
+        _used = 0;
+        _error = _statusCodes.ok;
+        uint64_t fingerprint;
+        if (!unsignedInteger(fingerprint, 4)) return _error;
+        if (fingerprint != _fingerprintOf(root)) return _statusCodes.schemaMismatch;
+        auto presence = read(1);
+        if (presence == nullptr) return _error;
+        BurpStatus::Status::Code code;
+        if (*presence) {
+            code = root.decode(*this);
+        } else {
+            code = root.deserialize(JsonVariant());
+        }
+        if (_error != _statusCodes.ok) return _error;
+        if (_position != _length) return _statusCodes.invalidInput;
+        return code;
+    }
+
+    const uint8_t * BinaryDecoder::read(const size_t length) {
+        if (_error != _statusCodes.ok) return nullptr;
+        if (length > _length - _position) {
+            _fail(_statusCodes.truncated);
+            return nullptr;
+        }
+        auto data = _data + _position;
+        _position += length;
+        return data;
+    }
+
+    bool BinaryDecoder::unsignedInteger(uint64_t & value, const size_t width) {
+        auto data = read(width);
+        if (data == nullptr) return false;
+        value = 0;
+        for (size_t index = width; index > 0; index--) {
+            value = (value << 8) | data[index - 1];
+        }
+        return true;
+    }
+
+    bool BinaryDecoder::lengthPrefix(size_t & length) {
+        length = 0;
+        for (size_t shift = 0; shift < sizeof(size_t) * 8; shift += 7) {
+            auto data = read(1);
+            if (data == nullptr) return false;
+            length |= static_cast<size_t>(*data & 0x7f) << shift;
+            if ((*data & 0x80) == 0) return true;
+        }
+        _fail(_statusCodes.invalidInput);
+        return false;
+    }
+
+    char * BinaryDecoder::string(const size_t length) {
+        auto data = read(length);
+        if (data == nullptr) return nullptr;
+        // room for the terminator
+        if (length >= _size - _used) {
+            _fail(_statusCodes.noMemory);
+            return nullptr;
+        }
+        auto dest = _buffer + _used;
+        memcpy(dest, data, length);
+        dest[length] = 0;
+        _used += length + 1;
+        return dest;
+    }
+
+    bool BinaryDecoder::ok() const {
+        return _error == _statusCodes.ok;
+    }
+
+    void BinaryDecoder::_fail(const BurpStatus::Status::Code code) {
+        _error = code;
+    }
+
+}
\ No newline at end of file
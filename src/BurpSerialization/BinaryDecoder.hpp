@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <BurpStatus.hpp>
+
+namespace BurpSerialization
+{
+
+    class Field;
+
+    // Reads the positional binary form written by BinaryEncoder into a
+    // Field tree. Strings are copied, null terminated, into the supplied
+    // buffer, as fields may hold pointers to them, so it must outlive the
+    // decoded values. Absent entries are deserialized as missing, so they
+    // report the same codes as they would from JSON.
+    class BinaryDecoder
+    {
+
+    public:
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code schemaMismatch;
+            const BurpStatus::Status::Code truncated;
+            const BurpStatus::Status::Code invalidInput;
+            const BurpStatus::Status::Code noMemory;
+        };
+
+        BinaryDecoder(char * buffer, const size_t size, const StatusCodes statusCodes);
+
+        // returns the decoder error or the code from the root field
+        BurpStatus::Status::Code decode(const Field & root, const uint8_t * data, const size_t length);
+
+        // for fields, these return nullptr or false once decoding has failed
+        const uint8_t * read(const size_t length);
+        bool unsignedInteger(uint64_t & value, const size_t width);
+        bool lengthPrefix(size_t & length);
+        // copied into the buffer and null terminated
+        char * string(const size_t length);
+
+        bool ok() const;
+
+    private:
+
+        char * const _buffer;
+        const size_t _size;
+        const StatusCodes _statusCodes;
+        const uint8_t * _data;
+        size_t _length;
+        size_t _position;
+        size_t _used;
+        BurpStatus::Status::Code _error;
+        // the schema does not change, so the last fingerprint is kept
+        const Field * _schema;
+        uint32_t _fingerprint;
+
+        uint32_t _fingerprintOf(const Field & root);
+        void _fail(const BurpStatus::Status::Code code);
+
+    };
+
+}
\ No newline at end of file
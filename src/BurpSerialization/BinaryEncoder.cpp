@@ -0,0 +1,78 @@
+#include <string.h>
+#include "BinaryEncoder.hpp"
+#include "Field.hpp"
+
+namespace BurpSerialization
+{
+
+    BinaryEncoder::BinaryEncoder(uint8_t * buffer, const size_t size) :
+        _buffer(buffer),
+        _size(size),
+        _length(0),
+        _failed(false),
+        _schema(nullptr),
+        _fingerprint(0)
+    {}
+
+    uint32_t BinaryEncoder::_fingerprintOf(const Field & root) {
+        if (_schema != &root) {
+            _schema = &root;
+            _fingerprint = root.fingerprint(hashSeed);
+        }
+        return _fingerprint;
+    }
+
+    bool BinaryEncoder::encode(const Field & root) {
+        _length = 0;
+        _failed = false;
+        if (!unsignedInteger(_fingerprintOf(root), 4)) return false;
+        auto isNull = root.isNull();
+        if (write(isNull ? 0 : 1) == 0) return false;
+        if (isNull) return true;
+        return root.encode(*this) && ok();
+    }
+
+    size_t BinaryEncoder::write(uint8_t c) {
+        return write(&c, 1);
+    }
+
+    size_t BinaryEncoder::write(const uint8_t * data, size_t length) {
+        if (_failed || length == 0) return 0;
+        if (length > _size - _length) {
+            _failed = true;
+            return 0;
+        }
+        memcpy(_buffer + _length, data, length);
+        _length += length;
+        return length;
+    }
+
+    bool BinaryEncoder::unsignedInteger(const uint64_t value, const size_t width) {
+        uint8_t bytes[8];
+        for (size_t index = 0; index < width; index++) {
+            bytes[index] = static_cast<uint8_t>(value >> (index * 8));
+        }
+        return write(bytes, width) == width;
+    }
+
+    bool BinaryEncoder::lengthPrefix(size_t length) {
+        uint8_t bytes[10];
+        size_t count = 0;
+        do {
+            bytes[count] = length & 0x7f;
+            length >>= 7;
+            if (length > 0) bytes[count] |= 0x80;
+            count++;
+        } while (length > 0);
+        return write(bytes, count) == count;
+    }
+
+    bool BinaryEncoder::ok() const {
+        return !_failed;
+    }
+
+    size_t BinaryEncoder::length() const {
+        return _length;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace BurpSerialization
+{
+
+    class Field;
+
+    // Positional binary form of a Field tree. The schema is known to
+    // both ends so no keys are sent: a fingerprint of the schema, a
+    // presence byte for the root, then each Object as a presence bitmap
+    // followed by its non null entries in order, each in the field's own
+    // fixed width or length prefixed form. Integers are little endian.
+    class BinaryEncoder
+    {
+
+    public:
+
+        BinaryEncoder(uint8_t * buffer, const size_t size);
+
+        // encode a whole tree from the start of the buffer
+        bool encode(const Field & root);
+
+        // for fields, failures are sticky
+        size_t write(uint8_t c);
+        size_t write(const uint8_t * data, size_t length);
+        bool unsignedInteger(const uint64_t value, const size_t width);
+        // LEB128, 1 byte for lengths below 128
+        bool lengthPrefix(size_t length);
+
+        bool ok() const;
+        size_t length() const;
+
+    private:
+
+        uint8_t * const _buffer;
+        const size_t _size;
+        size_t _length;
+        bool _failed;
+        // the schema does not change, so the last fingerprint is kept
+        const Field * _schema;
+        uint32_t _fingerprint;
+
+        uint32_t _fingerprintOf(const Field & root);
+
+    };
+
+}
\ No newline at end of file
@@ -3,38 +3,54 @@
 namespace BurpSerialization
 {
 
-    CStr::CStr(
+    template <template <class> class Codes>
+    BasicCStr<Codes>::BasicCStr(
         const size_t minLength,
         const size_t maxLength,
-        const StatusCodes statusCodes,
-        const char *& value
+        typename Codes<StatusCodes>::Argument statusCodes,
+        const char *& value,
+        StringPool * pool
     ) :
         _minLength(minLength),
         _maxLength(maxLength),
         _statusCodes(statusCodes),
-        _value(value)
+        _value(value),
+        _pool(pool)
     {}
 
-    BurpStatus::Status::Code CStr::deserialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicCStr<Codes>::deserialize(const JsonVariant & serialized) const {
         _value = nullptr;
         if (serialized.isNull()) {
-            return _statusCodes.notPresent;
+            return _statusCodes.get(&StatusCodes::notPresent);
         }
         if (serialized.is<const char *>()) {
-            auto value = serialized.as<const char *>();
-            if (strlen(value) < _minLength) {
-                return _statusCodes.tooShort;
-            }
-            if (strlen(value) > _maxLength) {
-                return _statusCodes.tooLong;
-            }
-            _value = value;
-            return _statusCodes.ok;
+            return _set(serialized.as<const char *>());
         }
-        return _statusCodes.wrongType;
+        return _statusCodes.get(&StatusCodes::wrongType);
     }
 
-    bool CStr::serialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicCStr<Codes>::_set(const char * value) const {
+        // one pass that stops past maxLength
+        size_t length = 0;
+        while (length <= _maxLength && value[length]) length++;
+        if (length < _minLength) {
+            return _statusCodes.get(&StatusCodes::tooShort);
+        }
+        if (length > _maxLength) {
+            return _statusCodes.get(&StatusCodes::tooLong);
+        }
+        _value = value;
+        if (_pool != nullptr) {
+            auto interned = _pool->intern(value, length);
+            if (interned != nullptr) _value = interned;
+        }
+        return _statusCodes.get(&StatusCodes::ok);
+    }
+
+    template <template <class> class Codes>
+    bool BasicCStr<Codes>::serialize(const JsonVariant & serialized) const {
         if (_value == nullptr) {
             serialized.clear();
             return true;
@@ -42,4 +58,41 @@ namespace BurpSerialization
         return serialized.set(_value);
     }
 
+    template <template <class> class Codes>
+    bool BasicCStr<Codes>::write(Writer & writer) const {
+        if (_value == nullptr) {
+            return writer.null();
+        }
+        return writer.string(_value);
+    }
+
+    template <template <class> class Codes>
+    bool BasicCStr<Codes>::isNull() const {
+        return _value == nullptr;
+    }
+
+    template <template <class> class Codes>
+    bool BasicCStr<Codes>::encode(BinaryEncoder & encoder) const {
+        auto length = strlen(_value);
+        return encoder.lengthPrefix(length) && encoder.write(reinterpret_cast<const uint8_t *>(_value), length) == length;
+    }
+
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicCStr<Codes>::decode(BinaryDecoder & decoder) const {
+        size_t length;
+        const char * value = nullptr;
+        if (decoder.lengthPrefix(length)) value = decoder.string(length);
+        if (value == nullptr) return deserialize(JsonVariant());
+        _value = nullptr;
+        return _set(value);
+    }
+
+    template <template <class> class Codes>
+    uint32_t BasicCStr<Codes>::fingerprint(const uint32_t hash) const {
+        return hashKey("s", hash);
+    }
+
+    template class BasicCStr<CopiedCodes>;
+    template class BasicCStr<SharedCodes>;
+
 }
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "Field.hpp"
+#include "Codes.hpp"
+#include "StringPool.hpp"
 
 namespace BurpSerialization
 {
 
-    class CStr : public Field
+    template <template <class> class Codes = CopiedCodes>
+    class BasicCStr : public Field
     {
 
     public:
@@ -18,23 +21,46 @@ namespace BurpSerialization
             const BurpStatus::Status::Code tooLong;
         };
 
-        CStr(
+        // serialize stores the pointer rather than a copy
+        static constexpr Capacity capacity(const size_t maxLength) {
+            return {0, JSON_STRING_SIZE(maxLength), 0};
+        }
+
+        // with a pool the value is interned, falling back to the document
+        // string if the pool is full
+        BasicCStr(
             const size_t minLength,
             const size_t maxLength,
-            const StatusCodes statusCodes,
-            const char *& value
+            typename Codes<StatusCodes>::Argument statusCodes,
+            const char *& value,
+            StringPool * pool = nullptr
         );
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
         bool serialize(const JsonVariant & serialized) const override;
+        bool write(Writer & writer) const override;
+        bool isNull() const override;
+        bool encode(BinaryEncoder & encoder) const override;
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override;
+        uint32_t fingerprint(const uint32_t hash) const override;
 
     private:
 
         const size_t _minLength;
         const size_t _maxLength;
-        const StatusCodes _statusCodes;
+        const Codes<StatusCodes> _statusCodes;
         const char *& _value;
+        StringPool * const _pool;
+
+        BurpStatus::Status::Code _set(const char * value) const;
 
     };
+
+    using CStr = BasicCStr<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedCStr = BasicCStr<SharedCodes>;
+
+    extern template class BasicCStr<CopiedCodes>;
+    extern template class BasicCStr<SharedCodes>;
     
 }
\ No newline at end of file
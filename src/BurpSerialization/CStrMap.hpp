@@ -1,12 +1,17 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
+#include <type_traits>
 #include "Field.hpp"
+#include "Codes.hpp"
 
 namespace BurpSerialization
 {
 
-    template <class Type, size_t count>
+    // Key is const char * or const FlashString * for keys kept in flash,
+    // as for Object names
+    template <class Type, size_t count, template <class> class Codes = CopiedCodes, class Key = const char *>
     class CStrMap : public Field
     {
 
@@ -25,35 +30,41 @@ namespace BurpSerialization
         };
 
         struct Choice {
-            const char * key;
+            Key key;
             Type value;
         };
 
         using Choices = std::array<Choice, count>;
 
-        CStrMap(Choices choices, const StatusCodes statusCodes, Value & value) :
+        // serialize stores a pointer to the choice key rather than a copy,
+        // unless the key is in flash
+        static constexpr Capacity capacity(const size_t maxKeyLength) {
+            return {0, JSON_STRING_SIZE(maxKeyLength), std::is_same<Key, const char *>::value ? 0 : JSON_STRING_SIZE(maxKeyLength)};
+        }
+
+        CStrMap(Choices choices, typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
             _choices(choices),
             _statusCodes(statusCodes),
             _value(value)
-        {}
+        {
+            _indexValues(Indexable());
+        }
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override {
             _value.isNull = true;
             if (serialized.isNull()) {
-                return _statusCodes.notPresent;
+                return _statusCodes.get(&StatusCodes::notPresent);
             }
             if (serialized.is<const char *>()) {
-                auto value = serialized.as<const char *>();
-                for (auto choice : _choices) {
-                    if (strcmp(choice.key, value) == 0) {
-                        _value.isNull = false;
-                        _value.value = choice.value;
-                        return _statusCodes.ok;
-                    }
+                auto index = _findKey(serialized.as<const char *>());
+                if (index < count) {
+                    _value.isNull = false;
+                    _value.value = _choices[index].value;
+                    return _statusCodes.get(&StatusCodes::ok);
                 }
-                return _statusCodes.invalidChoice;
+                return _statusCodes.get(&StatusCodes::invalidChoice);
             }
-            return _statusCodes.wrongType;
+            return _statusCodes.get(&StatusCodes::wrongType);
         }
 
         bool serialize(const JsonVariant & serialized) const override {
@@ -61,20 +72,131 @@ namespace BurpSerialization
             if (_value.isNull) {
                 return true;
             }
-            for (auto choice : _choices) {
-                if (choice.value == _value.value) {
-                    return serialized.set(choice.key);
-                }
+            auto index = _findValue(_value.value, Indexable());
+            if (index < count) {
+                return serialized.set(jsonString(_choices[index].key));
             }
             return false;
         }
 
-    private:
+        bool write(Writer & writer) const override {
+            if (_value.isNull) {
+                return writer.null();
+            }
+            auto index = _findValue(_value.value, Indexable());
+            if (index < count) {
+                return writer.string(_choices[index].key);
+            }
+            return false;
+        }
+
+        bool isNull() const override {
+            return _value.isNull;
+        }
+
+        // the index of the choice
+        bool encode(BinaryEncoder & encoder) const override {
+            auto index = _findValue(_value.value, Indexable());
+            if (index < count) {
+                return encoder.unsignedInteger(index, _indexWidth);
+            }
+            return false;
+        }
+
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override {
+            uint64_t index;
+            if (!decoder.unsignedInteger(index, _indexWidth)) return deserialize(JsonVariant());
+            _value.isNull = true;
+            if (index < count) {
+                _value.isNull = false;
+                _value.value = _choices[index].value;
+                return _statusCodes.get(&StatusCodes::ok);
+            }
+            return _statusCodes.get(&StatusCodes::invalidChoice);
+        }
+
+        uint32_t fingerprint(uint32_t hash) const override {
+            hash = hashKey("m", hash);
+            for (auto & choice : _choices) {
+                hash = hashKey(choice.key, hash);
+            }
+            return hash;
+        }
+
+    protected:
 
         const Choices _choices;
-        const StatusCodes _statusCodes;
+        const Codes<StatusCodes> _statusCodes;
         Value & _value;
 
+        // returns count if the key is not a choice
+        virtual size_t _findKey(const char * key) const {
+            for (size_t index = 0; index < count; index++) {
+                if (stringEquals(_choices[index].key, key)) return index;
+            }
+            return count;
+        }
+
+    private:
+
+        // integral and enum values can be ordered, and indexed directly if dense
+        using Indexable = std::integral_constant<bool, std::is_integral<Type>::value || std::is_enum<Type>::value>;
+
+        static constexpr size_t _indexWidth = count <= 0x100 ? 1 : count <= 0x10000 ? 2 : 4;
+
+        using Index = IndexType<count>;
+
+        // choice indices sorted by value, first choice wins for duplicate
+        // values, only kept for values that can be ordered
+        std::array<Index, Indexable::value ? count : 0> _byValue;
+        bool _dense = false;
+
+        static long long _ordinal(const Type value) {
+            return static_cast<long long>(value);
+        }
+
+        void _indexValues(std::false_type) {}
+
+        void _indexValues(std::true_type) {
+            for (size_t index = 0; index < count; index++) {
+                _byValue[index] = static_cast<Index>(index);
+            }
+            std::stable_sort(_byValue.begin(), _byValue.end(), [this](Index a, Index b) {
+                return _choices[a].value < _choices[b].value;
+            });
+            _dense = true;
+            for (size_t index = 1; index < count; index++) {
+                auto expected = _ordinal(_choices[_byValue[0]].value) + static_cast<long long>(index);
+                if (_ordinal(_choices[_byValue[index]].value) != expected) {
+                    _dense = false;
+                    break;
+                }
+            }
+        }
+
+        // returns count if the value is not a choice
+        size_t _findValue(const Type value, std::false_type) const {
+            for (size_t index = 0; index < count; index++) {
+                if (_choices[index].value == value) return index;
+            }
+            return count;
+        }
+
+        size_t _findValue(const Type value, std::true_type) const {
+            if (count == 0) return count;
+            auto first = _choices[_byValue[0]].value;
+            if (_dense) {
+                if (value < first) return count;
+                auto offset = static_cast<unsigned long long>(_ordinal(value) - _ordinal(first));
+                return offset < count ? _byValue[offset] : count;
+            }
+            auto pos = std::lower_bound(_byValue.begin(), _byValue.end(), value, [this](Index index, const Type value) {
+                return _choices[index].value < value;
+            });
+            if (pos != _byValue.end() && _choices[*pos].value == value) return *pos;
+            return count;
+        }
+
     };
     
 }
\ No newline at end of file
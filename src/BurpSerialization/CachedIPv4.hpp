@@ -0,0 +1,76 @@
+#pragma once
+
+#include "IPv4.hpp"
+
+namespace BurpSerialization
+{
+
+    // An IPv4 in text form that keeps the text of the value it last
+    // formatted. serialize hands the document that text as a const char *,
+    // which ArduinoJson links rather than copies, and only formats again
+    // once the value changes. The document then refers to the field: use
+    // it before the next serialize of a different value and while the
+    // field is alive. Array, which serializes every element through one
+    // field, copies the text instead.
+    //
+    //     CachedIPv4 address({...}, value);
+    template <template <class> class Codes = CopiedCodes>
+    class BasicCachedIPv4 : public BasicIPv4<Codes>
+    {
+
+    public:
+
+        using Base = BasicIPv4<Codes>;
+        using Value = typename Base::Value;
+        using StatusCodes = typename Base::StatusCodes;
+
+        // serialize copies no strings into the document
+        static constexpr Capacity capacity() {
+            return {0, JSON_STRING_SIZE(IPV4_MAX_LENGTH), 0};
+        }
+
+        BasicCachedIPv4(typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
+            Base(statusCodes, value)
+        {}
+
+        bool serialize(const JsonVariant & serialized) const override {
+            if (this->_value.isNull) {
+                serialized.clear();
+                return true;
+            }
+            return serialized.set(static_cast<const char *>(_text()));
+        }
+
+        bool write(Writer & writer) const override {
+            if (this->_value.isNull || writer.format() == Writer::Format::msgPack) {
+                return Base::write(writer);
+            }
+            auto text = _text();
+            return writer.string(text, _length);
+        }
+
+    private:
+
+        mutable char _cache[IPV4_MAX_LENGTH + 1];
+        mutable uint32_t _cached = 0;
+        // nothing is cached until the first format
+        mutable uint8_t _length = 0;
+
+        const char * _text() const {
+            if (_length == 0 || _cached != this->_value.value) {
+                _cached = this->_value.value;
+                _length = formatIPv4(_cached, _cache) - _cache;
+            }
+            return _cache;
+        }
+
+    };
+
+    using CachedIPv4 = BasicCachedIPv4<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedCachedIPv4 = BasicCachedIPv4<SharedCodes>;
+
+    template <template <class> class Codes>
+    struct LinksText<BasicCachedIPv4<Codes>> : std::true_type {};
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string.h>
+#include "MacAddress.hpp"
+
+namespace BurpSerialization
+{
+
+    // A MacAddress in text form that keeps the text of the value it last
+    // formatted, see CachedIPv4. The document refers to the field: use
+    // it before the next serialize of a different value and while the
+    // field is alive. Array, which serializes every element through one
+    // field, copies the text instead.
+    template <template <class> class Codes = CopiedCodes>
+    class BasicCachedMacAddress : public BasicMacAddress<Codes>
+    {
+
+    public:
+
+        using Base = BasicMacAddress<Codes>;
+        using Value = typename Base::Value;
+        using StatusCodes = typename Base::StatusCodes;
+
+        // serialize copies no strings into the document
+        static constexpr Capacity capacity() {
+            return {0, JSON_STRING_SIZE(MAC_ADDRESS_LENGTH), 0};
+        }
+
+        BasicCachedMacAddress(typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
+            Base(statusCodes, value)
+        {}
+
+        bool serialize(const JsonVariant & serialized) const override {
+            if (this->_value.isNull) {
+                serialized.clear();
+                return true;
+            }
+            return serialized.set(static_cast<const char *>(_text()));
+        }
+
+        bool write(Writer & writer) const override {
+            if (this->_value.isNull || writer.format() == Writer::Format::msgPack) {
+                return Base::write(writer);
+            }
+            return writer.string(_text(), MAC_ADDRESS_LENGTH);
+        }
+
+    private:
+
+        mutable char _cache[MAC_ADDRESS_LENGTH + 1];
+        mutable uint8_t _cached[MAC_ADDRESS_BYTE_COUNT];
+        // nothing is cached until the first format
+        mutable bool _isCached = false;
+
+        const char * _text() const {
+            if (!_isCached || memcmp(_cached, this->_value.value, MAC_ADDRESS_BYTE_COUNT) != 0) {
+                memcpy(_cached, this->_value.value, MAC_ADDRESS_BYTE_COUNT);
+                formatMacAddress(_cached, _cache);
+                _isCached = true;
+            }
+            return _cache;
+        }
+
+    };
+
+    using CachedMacAddress = BasicCachedMacAddress<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedCachedMacAddress = BasicCachedMacAddress<SharedCodes>;
+
+    template <template <class> class Codes>
+    struct LinksText<BasicCachedMacAddress<Codes>> : std::true_type {};
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <stddef.h>
+
+namespace BurpSerialization
+{
+
+    // Worst case JsonDocument capacity for a schema, worked out at compile
+    // time. Each field type has a static constexpr capacity() built from
+    // its limits and Object::capacity() adds up its entries, so
+    //
+    //     StaticJsonDocument<schemaCapacity.deserialize()> doc;
+    //
+    // is sized exactly. String sizes assume no deduplication.
+    struct Capacity {
+
+        // slots for objects, arrays and their members
+        size_t pool;
+        // strings copied into the document when deserializing from read
+        // only input, keys included
+        size_t inStrings;
+        // strings copied into the document by serialize
+        size_t outStrings;
+
+        // deserializeJson from const char *, Stream, String and the like
+        constexpr size_t deserialize() const {
+            return pool + inStrings;
+        }
+
+        // deserializeJson from char *, which keeps strings in the input
+        constexpr size_t deserializeInPlace() const {
+            return pool;
+        }
+
+        constexpr size_t serialize() const {
+            return pool + outStrings;
+        }
+
+        // enough for either direction
+        constexpr size_t document() const {
+            return deserialize() > serialize() ? deserialize() : serialize();
+        }
+
+        constexpr Capacity operator+(const Capacity other) const {
+            return {pool + other.pool, inStrings + other.inStrings, outStrings + other.outStrings};
+        }
+
+    };
+
+    constexpr Capacity sumCapacity() {
+        return {0, 0, 0};
+    }
+
+    template <class... Rest>
+    constexpr Capacity sumCapacity(const Capacity first, const Rest... rest) {
+        return first + sumCapacity(rest...);
+    }
+
+    // strlen for key and choice names in constant expressions
+    constexpr size_t constLength(const char * str) {
+        return *str ? 1 + constLength(str + 1) : 0;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <type_traits>
+#include "Flash.hpp"
+
+namespace BurpSerialization
+{
+
+    // How a field holds its status codes, given as the last template
+    // parameter of each field. Both give `get(&StatusCodes::ok)` for one
+    // code and `*` for a copy of them all.
+
+    // A copy in every field, the default, so the codes can be given in
+    // place:
+    //
+    //     IPv4 address({ok, notPresent, ...}, value);
+    template <class StatusCodes>
+    class CopiedCodes
+    {
+
+    public:
+
+        using Argument = const StatusCodes;
+
+        CopiedCodes(Argument statusCodes) :
+            _statusCodes(statusCodes)
+        {}
+
+        template <class Code>
+        Code get(const Code StatusCodes::* code) const {
+            return _statusCodes.*code;
+        }
+
+        const StatusCodes & operator*() const {
+            return _statusCodes;
+        }
+
+    private:
+
+        const StatusCodes _statusCodes;
+
+    };
+
+    // A pointer to one table shared by any number of fields. The table
+    // can be in PROGMEM, get() reads only the one code out of it:
+    //
+    //     const SharedIPv4::StatusCodes addressCodes PROGMEM = {ok, notPresent, ...};
+    //     SharedIPv4 address(&addressCodes, value);
+    template <class StatusCodes>
+    class SharedCodes
+    {
+
+    public:
+
+        using Argument = const StatusCodes *;
+
+        SharedCodes(Argument statusCodes) :
+            _statusCodes(statusCodes)
+        {}
+
+        template <class Code>
+        Code get(const Code StatusCodes::* code) const {
+            Code value;
+            flashRead(&value, &(_statusCodes->*code), sizeof(Code));
+            return value;
+        }
+
+        StatusCodes operator*() const {
+            // StatusCodes has const members, so it is copied in as bytes
+            typename std::aligned_storage<sizeof(StatusCodes), alignof(StatusCodes)>::type storage;
+            flashRead(&storage, _statusCodes, sizeof(StatusCodes));
+            return *reinterpret_cast<const StatusCodes *>(&storage);
+        }
+
+    private:
+
+        const StatusCodes * _statusCodes;
+
+    };
+
+}
\ No newline at end of file
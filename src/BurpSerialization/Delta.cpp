@@ -0,0 +1,93 @@
+#include <string.h>
+#include "Delta.hpp"
+
+namespace BurpSerialization
+{
+
+    constexpr uint16_t Delta::notStored;
+
+    Delta::Delta(Slot * slots, const size_t count, uint8_t * buffer, const size_t size) :
+        _slots(slots),
+        _count(count),
+        _published(buffer),
+        _current(buffer + size),
+        _size(size),
+        _position(0),
+        _publishedOffset(0),
+        _currentOffset(0),
+        _primed(false)
+    {
+        reset();
+    }
+
+    size_t Delta::count() const {
+        return _count;
+    }
+
+    bool Delta::changed() const {
+        return _count > 0 && _slots[0].dirty;
+    }
+
+    void Delta::reset() {
+        for (size_t index = 0; index < _count; index++) {
+            _slots[index] = {notStored, notStored, true, false};
+        }
+        _primed = false;
+        rewind();
+    }
+
+    void Delta::rewind() {
+        _position = 0;
+        _publishedOffset = 0;
+        _currentOffset = 0;
+    }
+
+    BinaryEncoder Delta::encoder() const {
+        return BinaryEncoder(_current + _currentOffset, _size - _currentOffset);
+    }
+
+    size_t Delta::mark(const BinaryEncoder & encoder) {
+        auto index = _position++;
+        auto & slot = _slots[index];
+        slot.current = encoder.ok() && encoder.length() < notStored ? encoder.length() : notStored;
+        // before the first commit every field is new, and bytes that
+        // were not kept cannot be compared
+        slot.replaced = !_primed || slot.current == notStored || slot.current != slot.published ||
+            memcmp(_current + _currentOffset, _published + _publishedOffset, slot.current) != 0;
+        slot.dirty = slot.replaced;
+        if (slot.current != notStored) _currentOffset += slot.current;
+        if (slot.published != notStored) _publishedOffset += slot.published;
+        return index;
+    }
+
+    bool Delta::replaced(const size_t index) const {
+        return _slots[index].replaced;
+    }
+
+    bool Delta::dirty(const size_t index) const {
+        return _slots[index].dirty;
+    }
+
+    void Delta::setDirty(const size_t index) {
+        _slots[index].dirty = true;
+    }
+
+    size_t Delta::position() const {
+        return _position;
+    }
+
+    void Delta::skip(const size_t count) {
+        _position += count;
+    }
+
+    void Delta::commit() {
+        for (size_t index = 0; index < _count; index++) {
+            _slots[index].published = _slots[index].current;
+        }
+        auto published = _published;
+        _published = _current;
+        _current = published;
+        _primed = true;
+    }
+
+}
\ No newline at end of file
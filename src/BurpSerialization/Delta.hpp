@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "BinaryEncoder.hpp"
+
+namespace BurpSerialization
+{
+
+    // What a Field tree last published, for Serialization::serializeDelta.
+    // There is one slot per field in depth first order, Field::deltaSlots()
+    // of the root in all, and a buffer holding the binary form of each
+    // slot's value, see BinaryEncoder, in the same order. Each delta marks
+    // the fields whose bytes differ from those of the last successful
+    // delta, then serializes only the Object entries on the way to them,
+    // so any number of changes between publishes go out as one message.
+    // Values whose bytes do not fit in the rest of the buffer count as
+    // changed every time, so size it to the tree's binary form plus a
+    // byte a slot. Null values are serialized as null, so applying a
+    // delta as a JSON merge patch gives the current values.
+    class Delta
+    {
+
+    public:
+
+        struct Slot {
+            // lengths of the slot's bytes, notStored when they did not fit
+            uint16_t published;
+            uint16_t current;
+            bool replaced;
+            bool dirty;
+        };
+
+        // buffer holds the published and the current bytes, size of each
+        Delta(Slot * slots, const size_t count, uint8_t * buffer, const size_t size);
+
+        size_t count() const;
+        // whether the last delta had anything in it
+        bool changed() const;
+        // the next delta has everything
+        void reset();
+
+        // For fields. Each pass over the tree starts at the first slot.
+        void rewind();
+        // writes the next slot's bytes into the buffer
+        BinaryEncoder encoder() const;
+        // records what was written to encoder() for the next slot,
+        // returns its index
+        size_t mark(const BinaryEncoder & encoder);
+        // the slot's own bytes changed
+        bool replaced(const size_t index) const;
+        // replaced, or a slot below it changed
+        bool dirty(const size_t index) const;
+        void setDirty(const size_t index);
+        size_t position() const;
+        void skip(const size_t count);
+        // the current bytes become the published ones
+        void commit();
+
+    private:
+
+        static constexpr uint16_t notStored = UINT16_MAX;
+
+        Slot * const _slots;
+        const size_t _count;
+        uint8_t * _published;
+        uint8_t * _current;
+        const size_t _size;
+        size_t _position;
+        // where the next slot's bytes are in each half of the buffer
+        size_t _publishedOffset;
+        size_t _currentOffset;
+        bool _primed;
+
+    };
+
+    // A Delta with its slots and buffer inline
+    template <size_t slotCount, size_t byteCount>
+    class StaticDelta : public Delta
+    {
+
+    public:
+
+        StaticDelta() :
+            Delta(_slots, slotCount, _buffer, byteCount)
+        {}
+
+    private:
+
+        Slot _slots[slotCount];
+        uint8_t _buffer[2 * byteCount];
+
+    };
+
+}
\ No newline at end of file
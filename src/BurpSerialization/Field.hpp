@@ -1,7 +1,14 @@
 #pragma once
 
+#include <type_traits>
 #include <ArduinoJson.h>
 #include <BurpStatus.hpp>
+#include "Writer.hpp"
+#include "BinaryEncoder.hpp"
+#include "BinaryDecoder.hpp"
+#include "KeyIndex.hpp"
+#include "Capacity.hpp"
+#include "Delta.hpp"
 
 namespace BurpSerialization
 {
@@ -13,6 +20,123 @@ namespace BurpSerialization
         virtual BurpStatus::Status::Code deserialize(const JsonVariant & src) const = 0;
         virtual bool serialize(const JsonVariant & dest) const = 0;
 
+        // Like deserialize, but returns the first code that is not ok and
+        // leaves the rest of the value unread, see Serialization::Mode.
+        // Containers override it, leaves have nothing to skip.
+        virtual BurpStatus::Status::Code deserializeFailFast(const JsonVariant & src) const {
+            return deserialize(src);
+        }
+
+        // Apply a JSON merge patch (RFC 7386). Containers take only the
+        // members present and leave the others as they are, null removes
+        // a member. Anything else replaces the value, as deserialize does.
+        virtual BurpStatus::Status::Code deserializePatch(const JsonVariant & patch) const {
+            return deserialize(patch);
+        }
+
+        // Write JSON text or MessagePack directly, without a document. The
+        // default goes through a small document and so only suits leaves;
+        // all of the library's fields override it.
+        virtual bool write(Writer & writer) const {
+            StaticJsonDocument<64> doc;
+            if (!serialize(doc.to<JsonVariant>())) return false;
+            if (!writer.beginValue()) return false;
+            if (writer.format() == Writer::Format::msgPack) {
+                serializeMsgPack(doc, writer);
+            } else {
+                serializeJson(doc, writer);
+            }
+            return writer.ok();
+        }
+
+        // MessagePack bin values, from MsgPackParser. Fields without a
+        // binary form are handed an empty array, which they reject.
+        virtual BurpStatus::Status::Code deserializeBinary(const uint8_t *, const size_t) const {
+            StaticJsonDocument<16> doc;
+            doc.to<JsonArray>();
+            return deserialize(doc.as<JsonVariant>());
+        }
+
+        // Positional binary form, see BinaryEncoder. Null values are only
+        // marked in the enclosing presence bitmap, so encode and decode
+        // are only called with a value. The defaults carry the value as
+        // length prefixed JSON text; all of the library's fields override
+        // them with a compact form.
+        virtual bool isNull() const {
+            StaticJsonDocument<64> doc;
+            serialize(doc.to<JsonVariant>());
+            return doc.isNull();
+        }
+
+        virtual bool encode(BinaryEncoder & encoder) const {
+            StaticJsonDocument<64> doc;
+            if (!serialize(doc.to<JsonVariant>())) return false;
+            if (!encoder.lengthPrefix(measureJson(doc))) return false;
+            serializeJson(doc, encoder);
+            return encoder.ok();
+        }
+
+        virtual BurpStatus::Status::Code decode(BinaryDecoder & decoder) const {
+            StaticJsonDocument<64> doc;
+            size_t length;
+            char * text = nullptr;
+            if (decoder.lengthPrefix(length)) text = decoder.string(length);
+            // a char * input is parsed in place, so strings stay in the decoder's buffer
+            if (text == nullptr || deserializeJson(doc, text, length)) return deserialize(JsonVariant());
+            return deserialize(doc.as<JsonVariant>());
+        }
+
+        // mixes anything that affects the binary layout into the hash
+        virtual uint32_t fingerprint(const uint32_t hash) const {
+            return hashKey("json", hash);
+        }
+
+        // Change tracking for Serialization::serializeDelta, see Delta.
+        // Leaves take one slot holding a presence byte and their binary
+        // form and are serialized whole when it changes; containers with
+        // members that can be sent on their own override all three.
+        virtual size_t deltaSlots() const {
+            return 1;
+        }
+
+        // marks this field's slots, returns whether anything changed
+        virtual bool markChanged(Delta & delta) const {
+            auto encoder = delta.encoder();
+            auto isNull = this->isNull();
+            if (encoder.write(isNull ? 0 : 1) == 1 && !isNull) encode(encoder);
+            return delta.dirty(delta.mark(encoder));
+        }
+
+        // only called when markChanged returned true
+        virtual bool serializeDelta(const JsonVariant & dest, Delta & delta) const {
+            delta.skip(1);
+            return serialize(dest);
+        }
+
+        // Incremental deserialization, driven by Parser and
+        // MsgPackParser. Leaves only need deserialize, containers
+        // override these to take their members or elements one at a
+        // time.
+
+        // return false to have the container passed to deserialize instead
+        virtual bool beginObject() const { return false; }
+        virtual bool beginArray() const { return false; }
+        // the field to receive the next member or element, nullptr to skip it
+        virtual const Field * member(const char *) const { return nullptr; }
+        virtual const Field * element() const { return nullptr; }
+        // the code returned for the last member or element
+        virtual void childDeserialized(const BurpStatus::Status::Code) const {}
+        // the code for the whole container
+        virtual BurpStatus::Status::Code endContainer() const { return 0; }
+
     };
+
+    // Whether a field's serialize links the document to text held by the
+    // field or its value rather than copying it, so that serializing
+    // another value through the same field changes what the document
+    // reads. Array serializes every element through one field and has
+    // the document copy the text of such elements.
+    template <class FieldType>
+    struct LinksText : std::false_type {};
     
-}
\ No newline at end of file
+}
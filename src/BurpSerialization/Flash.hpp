@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#ifdef BURP_NATIVE
+// native builds have no separate flash, let schemas mark tables the same
+// way on both
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#else
+#include <Arduino.h>
+#endif
+
+namespace BurpSerialization
+{
+
+    // A string in PROGMEM, the type F() and FPSTR() give on Arduino. On
+    // native builds it is only a marker and the string is ordinary memory,
+    // read through the same functions.
+#ifdef BURP_NATIVE
+    class FlashString;
+#else
+    using FlashString = __FlashStringHelper;
+#endif
+
+    // for a char array declared PROGMEM
+    inline const FlashString * flashString(const char * string) {
+        return reinterpret_cast<const FlashString *>(string);
+    }
+
+    // Copies out of PROGMEM, which on the ESP8266 can only be read a whole
+    // aligned word at a time
+    inline void flashRead(void * dest, const void * src, const size_t length) {
+#ifdef BURP_NATIVE
+        memcpy(dest, src, length);
+#else
+        memcpy_P(dest, src, length);
+#endif
+    }
+
+    // Object names and CStrMap keys are either const char * or const
+    // FlashString *, these read either
+
+    inline char stringAt(const char * string, const size_t index) {
+        return string[index];
+    }
+
+    inline char stringAt(const FlashString * string, const size_t index) {
+#ifdef BURP_NATIVE
+        return reinterpret_cast<const char *>(string)[index];
+#else
+        return static_cast<char>(pgm_read_byte(reinterpret_cast<const char *>(string) + index));
+#endif
+    }
+
+    inline size_t stringLength(const char * string) {
+        return strlen(string);
+    }
+
+    inline size_t stringLength(const FlashString * string) {
+#ifdef BURP_NATIVE
+        return strlen(reinterpret_cast<const char *>(string));
+#else
+        return strlen_P(reinterpret_cast<const char *>(string));
+#endif
+    }
+
+    // other is always in RAM
+    inline bool stringEquals(const char * string, const char * other) {
+        return strcmp(string, other) == 0;
+    }
+
+    inline bool stringEquals(const FlashString * string, const char * other) {
+#ifdef BURP_NATIVE
+        return strcmp(other, reinterpret_cast<const char *>(string)) == 0;
+#else
+        return strcmp_P(other, reinterpret_cast<const char *>(string)) == 0;
+#endif
+    }
+
+    // ArduinoJson links const char * and copies other strings. A flash
+    // string is passed as it is on Arduino and as char * on native builds,
+    // so it is copied into the document either way.
+    inline const char * jsonString(const char * string) {
+        return string;
+    }
+
+#ifdef BURP_NATIVE
+    inline char * jsonString(const FlashString * string) {
+        return const_cast<char *>(reinterpret_cast<const char *>(string));
+    }
+#else
+    inline const FlashString * jsonString(const FlashString * string) {
+        return string;
+    }
+#endif
+
+}
\ No newline at end of file
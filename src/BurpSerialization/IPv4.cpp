@@ -1,105 +1,257 @@
+#include <string.h>
 #include "IPv4.hpp"
 
 namespace BurpSerialization
 {
 
-    char * uint8ToStr(uint8_t src, char * dest) {
-        uint8_t ones = src % 10;
-        uint8_t tens = (src - ones) % 100;
-        uint8_t hundreds = src - tens - ones;
-        if (hundreds > 0) {
-            *dest = '0' + hundreds / 100;
-            dest++;
-            *dest = '0' + tens / 10;
-            dest++;
-            *dest = '0' + ones;
-        } else if (tens > 0) {
-            *dest = '0' + tens / 10;
-            dest++;
-            *dest = '0' + ones;
-        } else {
-            *dest = '0' + ones;
-        }
-        return dest + 1;
-    }
+    namespace
+    {
+
+        // the decimal text of every byte, copied four bytes at a time so
+        // the unused bytes are zeros
+        const char decimal[256][4] PROGMEM = {
+        "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15",
+        "16", "17", "18", "19", "20", "21", "22", "23", "24", "25", "26", "27", "28", "29", "30", "31",
+        "32", "33", "34", "35", "36", "37", "38", "39", "40", "41", "42", "43", "44", "45", "46", "47",
+        "48", "49", "50", "51", "52", "53", "54", "55", "56", "57", "58", "59", "60", "61", "62", "63",
+        "64", "65", "66", "67", "68", "69", "70", "71", "72", "73", "74", "75", "76", "77", "78", "79",
+        "80", "81", "82", "83", "84", "85", "86", "87", "88", "89", "90", "91", "92", "93", "94", "95",
+        "96", "97", "98", "99", "100", "101", "102", "103", "104", "105", "106", "107", "108", "109", "110", "111",
+        "112", "113", "114", "115", "116", "117", "118", "119", "120", "121", "122", "123", "124", "125", "126", "127",
+        "128", "129", "130", "131", "132", "133", "134", "135", "136", "137", "138", "139", "140", "141", "142", "143",
+        "144", "145", "146", "147", "148", "149", "150", "151", "152", "153", "154", "155", "156", "157", "158", "159",
+        "160", "161", "162", "163", "164", "165", "166", "167", "168", "169", "170", "171", "172", "173", "174", "175",
+        "176", "177", "178", "179", "180", "181", "182", "183", "184", "185", "186", "187", "188", "189", "190", "191",
+        "192", "193", "194", "195", "196", "197", "198", "199", "200", "201", "202", "203", "204", "205", "206", "207",
+        "208", "209", "210", "211", "212", "213", "214", "215", "216", "217", "218", "219", "220", "221", "222", "223",
+        "224", "225", "226", "227", "228", "229", "230", "231", "232", "233", "234", "235", "236", "237", "238", "239",
+        "240", "241", "242", "243", "244", "245", "246", "247", "248", "249", "250", "251", "252", "253", "254", "255"
+        };
+
+        constexpr uint64_t ones = 0x0101010101010101ull;
+        constexpr uint64_t lowBits = 0x7f7f7f7f7f7f7f7full;
+        constexpr uint64_t highBits = 0x8080808080808080ull;
+
+        // the high bit of each byte below limit, at most 0x80, exactly:
+        // adding to the low seven bits never carries into the next byte
+        uint64_t below(const uint64_t word, const uint8_t limit) {
+            return ~(((word & lowBits) + (0x80 - limit) * ones) | word) & highBits;
+        }
+
+        // one bit per byte from the high bits, byte 0 in bit 0
+        uint8_t gather(const uint64_t highs) {
+            return static_cast<uint8_t>(((highs >> 7) * 0x0102040810204080ull) >> 56);
+        }
+
+        uint64_t load(const char * text) {
+            uint64_t word;
+            memcpy(&word, text, sizeof(word));
+            return word;
+        }
+
+        // one character at a time, for anything the fast path does not take
+        IPv4Text parseOctet(const char *& pos, uint32_t & dest) {
+            uint16_t value = 0;
+            auto start = pos;
+            while (*pos >= '0' && *pos <= '9') {
+                value *= 10;
+                value += (*pos) - '0';
+                pos++;
+                if (value > 255) return IPv4Text::outOfRange;
+            }
+            if (pos == start) return IPv4Text::missingField;
+            dest += value;
+            return IPv4Text::ok;
+        }
+
+        IPv4Text parseBytewise(const char * src, uint32_t & dest) {
+            dest = 0;
+            auto pos = src;
+            for (uint8_t field = 0; field < IPV4_BYTE_COUNT; field++) {
+                dest *= 256;
+                auto result = parseOctet(pos, dest);
+                if (result != IPv4Text::ok) return result;
+                if (field < IPV4_BYTE_COUNT - 1) {
+                    if (*pos != '.') return IPv4Text::invalidCharacter;
+                } else {
+                    if (*pos != 0) return IPv4Text::excessCharacters;
+                }
+                pos++;
+            }
+            return IPv4Text::ok;
+        }
+
+        template <class StatusCodes>
+        BurpStatus::Status::Code ipv4Code(const IPv4Text result, const StatusCodes & statusCodes) {
+            switch (result) {
+                case IPv4Text::ok: return statusCodes.ok;
+                case IPv4Text::invalidCharacter: return statusCodes.invalidCharacter;
+                case IPv4Text::outOfRange: return statusCodes.outOfRange;
+                case IPv4Text::missingField: return statusCodes.missingField;
+                default: return statusCodes.excessCharacters;
+            }
+        }
 
-    BurpStatus::Status::Code strToUInt8(const char *& pos, uint32_t * dest, IPv4::StatusCodes statusCodes) {
-        uint16_t value = 0;
-        auto start = pos;
-        while (*pos >= '0' && *pos <= '9') {
-            value *= 10;
-            value += (*pos) - '0';
-            pos++;
-            if (value > 255) return statusCodes.outOfRange;
-        }
-        if (pos == start) return statusCodes.missingField;
-        *dest += value;
-        return statusCodes.ok;
     }
 
-    BurpStatus::Status::Code strToIPv4(const char * src, uint32_t * dest, IPv4::StatusCodes statusCodes) {
-        *dest = 0;
-        auto pos = src;
+    IPv4Text parseIPv4(const char * src, uint32_t & dest) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return parseBytewise(src, dest);
+#else
+        // Two word loads inside the string and its terminator, the first
+        // from the start and the second ending on the terminator, cover
+        // every character of the shortest to the longest dotted quad.
+        // Copying into a buffer a byte at a time instead would stall the
+        // word loads behind the byte stores.
+        auto length = strnlen(src, IPV4_MAX_LENGTH + 1);
+        if (length < IPV4_MIN_LENGTH || length > IPV4_MAX_LENGTH) return parseBytewise(src, dest);
+        auto offset = length - IPV4_MIN_LENGTH;
+        auto first = load(src);
+        auto last = load(src + offset);
+        auto digits = gather(below(first ^ ('0' * ones), 10)) | gather(below(last ^ ('0' * ones), 10)) << offset;
+        auto dots = gather(below(first ^ ('.' * ones), 1)) | gather(below(last ^ ('.' * ones), 1)) << offset;
+        const uint32_t used = (1u << length) - 1;
+        // exactly three dots and otherwise digits, the rest is a failure
+        // and the byte at a time parser finds which
+        if (((digits | dots) & used) != used || __builtin_popcount(dots) != 3) {
+            return parseBytewise(src, dest);
+        }
+        // with room to read three digits from the last field
+        char text[IPV4_MAX_LENGTH + 3] = {};
+        memcpy(text, &first, sizeof(first));
+        memcpy(text + offset, &last, sizeof(last));
+        // the place value of each digit by the number of digits
+        static const uint8_t scales[4][3] = {{0, 0, 0}, {1, 0, 0}, {10, 1, 0}, {100, 10, 1}};
+        uint32_t ends = dots | (1u << length);
+        uint32_t value = 0;
+        size_t start = 0;
         for (uint8_t field = 0; field < IPV4_BYTE_COUNT; field++) {
-            *dest *= 256;
-            auto code = strToUInt8(pos, dest, statusCodes);
-            if (code != statusCodes.ok) return code;
-            if (field < IPV4_BYTE_COUNT - 1) {
-                if (*pos != '.') return statusCodes.invalidCharacter;
-            } else {
-                if (*pos != 0) return statusCodes.excessCharacters;
-            }
-            pos++;
+            size_t end = __builtin_ctz(ends);
+            ends &= ends - 1;
+            auto width = end - start;
+            if (width - 1 > 2) return parseBytewise(src, dest);
+            auto scale = scales[width];
+            auto octet = (text[start] - '0') * scale[0] + (text[start + 1] - '0') * scale[1] + (text[start + 2] - '0') * scale[2];
+            if (octet > 255) return parseBytewise(src, dest);
+            value = (value << 8) | octet;
+            start = end + 1;
+        }
+        dest = value;
+        return IPv4Text::ok;
+#endif
+    }
+
+    char * formatIPv4(const uint32_t src, char * dest) {
+        auto pos = dest;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            auto octet = static_cast<uint8_t>(src >> shift);
+            flashRead(pos, decimal[octet], sizeof(decimal[octet]));
+            pos += octet >= 100 ? 3 : octet >= 10 ? 2 : 1;
+            if (shift > 0) *pos++ = '.';
         }
-        return statusCodes.ok;
+        return pos;
     }
 
-    IPv4::IPv4(const StatusCodes statusCodes, Value & value) :
+    template <template <class> class Codes>
+    BasicIPv4<Codes>::BasicIPv4(typename Codes<StatusCodes>::Argument statusCodes, Value & value, const IPv4Form form) :
         _statusCodes(statusCodes),
-        _value(value)
+        _value(value),
+        _form(form)
     {}
 
-    BurpStatus::Status::Code IPv4::deserialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicIPv4<Codes>::deserialize(const JsonVariant & serialized) const {
         _value.isNull = true;
         if (serialized.isNull()) {
-            return _statusCodes.notPresent;
+            return _statusCodes.get(&StatusCodes::notPresent);
         }
         if (serialized.is<const char *>()) {
-            auto code = strToIPv4(serialized.as<const char *>(), &(_value.value), _statusCodes);
-            if (code != _statusCodes.ok) return code;
+            auto result = parseIPv4(serialized.as<const char *>(), _value.value);
+            if (result != IPv4Text::ok) return ipv4Code(result, *_statusCodes);
             _value.isNull = false;
-            return _statusCodes.ok;
+            return _statusCodes.get(&StatusCodes::ok);
         }
-        return _statusCodes.wrongType;
+        if (serialized.is<uint32_t>()) {
+            _value.value = serialized.as<uint32_t>();
+            _value.isNull = false;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+        if (serialized.is<int64_t>() || serialized.is<uint64_t>()) {
+            return _statusCodes.get(&StatusCodes::outOfRange);
+        }
+        return _statusCodes.get(&StatusCodes::wrongType);
     }
 
-    bool IPv4::serialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    bool BasicIPv4<Codes>::serialize(const JsonVariant & serialized) const {
         if (_value.isNull) {
             serialized.clear();
             return true;
         }
-        char szIP[16] = {};
-        char * pos = szIP;
-        uint32_t temp1 = _value.value;
-        uint32_t temp2 = temp1 >> 8;
-        uint32_t byte4 = temp1 - (temp2 << 8);
-        temp1 = temp2 >> 8;
-        uint32_t byte3 = temp2 - (temp1 << 8);
-        temp2 = temp1 >> 8;
-        uint32_t byte2 = temp1 - (temp2 << 8);
-        temp1 = temp2 >> 8;
-        uint32_t byte1 = temp2 - (temp1 << 8);
-        pos = uint8ToStr(byte1, pos);
-        *pos = '.';
-        pos++;
-        pos = uint8ToStr(byte2, pos);
-        *pos = '.';
-        pos++;
-        pos = uint8ToStr(byte3, pos);
-        *pos = '.';
-        pos++;
-        pos = uint8ToStr(byte4, pos);
+        if (_form == IPv4Form::integer) {
+            return serialized.set(_value.value);
+        }
+        char szIP[IPV4_MAX_LENGTH + 1];
+        formatIPv4(_value.value, szIP);
         return serialized.set(szIP);
     }
 
+    template <template <class> class Codes>
+    bool BasicIPv4<Codes>::write(Writer & writer) const {
+        if (_value.isNull) {
+            return writer.null();
+        }
+        if (_form == IPv4Form::integer) {
+            return writer.unsignedInteger(_value.value);
+        }
+        if (writer.format() == Writer::Format::msgPack) {
+            uint8_t bytes[IPV4_BYTE_COUNT];
+            ipv4ToBytes(_value.value, bytes);
+            return writer.binary(bytes, IPV4_BYTE_COUNT);
+        }
+        char szIP[IPV4_MAX_LENGTH + 1];
+        auto end = formatIPv4(_value.value, szIP);
+        return writer.string(szIP, end - szIP);
+    }
+
+    // network byte order
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicIPv4<Codes>::deserializeBinary(const uint8_t * data, const size_t length) const {
+        _value.isNull = true;
+        if (length != IPV4_BYTE_COUNT) {
+            return _statusCodes.get(&StatusCodes::wrongType);
+        }
+        _value.value = ipv4FromBytes(data);
+        _value.isNull = false;
+        return _statusCodes.get(&StatusCodes::ok);
+    }
+
+    template <template <class> class Codes>
+    bool BasicIPv4<Codes>::isNull() const {
+        return _value.isNull;
+    }
+
+    // network byte order, as for MessagePack
+    template <template <class> class Codes>
+    bool BasicIPv4<Codes>::encode(BinaryEncoder & encoder) const {
+        uint8_t bytes[IPV4_BYTE_COUNT];
+        ipv4ToBytes(_value.value, bytes);
+        return encoder.write(bytes, IPV4_BYTE_COUNT) == IPV4_BYTE_COUNT;
+    }
+
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicIPv4<Codes>::decode(BinaryDecoder & decoder) const {
+        auto data = decoder.read(IPV4_BYTE_COUNT);
+        if (data == nullptr) return deserialize(JsonVariant());
+        return deserializeBinary(data, IPV4_BYTE_COUNT);
+    }
+
+    template <template <class> class Codes>
+    uint32_t BasicIPv4<Codes>::fingerprint(const uint32_t hash) const {
+        return hashKey("ipv4", hash);
+    }
+
+    template class BasicIPv4<CopiedCodes>;
+    template class BasicIPv4<SharedCodes>;
+
 }
\ No newline at end of file
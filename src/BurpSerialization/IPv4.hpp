@@ -1,13 +1,73 @@
 #pragma once
 
+#include <string.h>
 #include "Field.hpp"
+#include "Codes.hpp"
 
 namespace BurpSerialization
 {
 
     constexpr size_t IPV4_BYTE_COUNT = 4;
+    constexpr size_t IPV4_MIN_LENGTH = 7;
+    constexpr size_t IPV4_MAX_LENGTH = 15;
 
-    class IPv4 : public Field
+    // the dotted quad parse results, mapped onto each field's codes
+    enum class IPv4Text {
+        ok,
+        invalidCharacter,
+        outOfRange,
+        missingField,
+        excessCharacters
+    };
+
+    // Classifies the characters eight at a time and takes the common
+    // shape, three dots between one to three digits, straight from that.
+    // Anything else goes character by character to find the code. The
+    // value is in host byte order, 10.0.0.1 is 0x0a000001.
+    IPv4Text parseIPv4(const char * src, uint32_t & dest);
+    // writes the dotted quad into IPV4_MAX_LENGTH + 1 bytes, null
+    // terminated, and returns the end of the text
+    char * formatIPv4(const uint32_t src, char * dest);
+
+    // the four bytes in network byte order, most significant first
+    inline void ipv4ToBytes(const uint32_t src, uint8_t dest[IPV4_BYTE_COUNT]) {
+        dest[0] = static_cast<uint8_t>(src >> 24);
+        dest[1] = static_cast<uint8_t>(src >> 16);
+        dest[2] = static_cast<uint8_t>(src >> 8);
+        dest[3] = static_cast<uint8_t>(src);
+    }
+
+    inline uint32_t ipv4FromBytes(const uint8_t src[IPV4_BYTE_COUNT]) {
+        return (static_cast<uint32_t>(src[0]) << 24) | (static_cast<uint32_t>(src[1]) << 16) | (static_cast<uint32_t>(src[2]) << 8) | src[3];
+    }
+
+    // The value as a sockaddr_in's sin_addr.s_addr or lwIP's IPAddress
+    // holds it, network byte order in memory whatever the host, like
+    // htonl and ntohl without a network stack
+    inline uint32_t ipv4ToNetwork(const uint32_t value) {
+        uint8_t bytes[IPV4_BYTE_COUNT];
+        ipv4ToBytes(value, bytes);
+        uint32_t network;
+        memcpy(&network, bytes, sizeof(network));
+        return network;
+    }
+
+    inline uint32_t ipv4FromNetwork(const uint32_t network) {
+        uint8_t bytes[IPV4_BYTE_COUNT];
+        memcpy(bytes, &network, sizeof(network));
+        return ipv4FromBytes(bytes);
+    }
+
+    // how serialize and write give the value, text is the dotted quad
+    // and integer the host order value, 10.0.0.1 is 167772161. Both are
+    // accepted by deserialize whatever the form.
+    enum class IPv4Form {
+        text,
+        integer
+    };
+
+    template <template <class> class Codes = CopiedCodes>
+    class BasicIPv4 : public Field
     {
 
     public:
@@ -27,16 +87,37 @@ namespace BurpSerialization
             const BurpStatus::Status::Code excessCharacters;
         };
 
-        IPv4(const StatusCodes statusCodes, Value & value);
+        // for values in the given form, the integer form needs no strings
+        static constexpr Capacity capacity(const IPv4Form form = IPv4Form::text) {
+            return form == IPv4Form::text ?
+                Capacity{0, JSON_STRING_SIZE(IPV4_MAX_LENGTH), JSON_STRING_SIZE(IPV4_MAX_LENGTH)} :
+                Capacity{0, 0, 0};
+        }
+
+        BasicIPv4(typename Codes<StatusCodes>::Argument statusCodes, Value & value, const IPv4Form form = IPv4Form::text);
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
         bool serialize(const JsonVariant & serialized) const override;
+        bool write(Writer & writer) const override;
+        BurpStatus::Status::Code deserializeBinary(const uint8_t * data, const size_t length) const override;
+        bool isNull() const override;
+        bool encode(BinaryEncoder & encoder) const override;
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override;
+        uint32_t fingerprint(const uint32_t hash) const override;
 
-    private:
+    protected:
 
-        const StatusCodes _statusCodes;
+        const Codes<StatusCodes> _statusCodes;
         Value & _value;
+        const IPv4Form _form;
 
     };
+
+    using IPv4 = BasicIPv4<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedIPv4 = BasicIPv4<SharedCodes>;
+
+    extern template class BasicIPv4<CopiedCodes>;
+    extern template class BasicIPv4<SharedCodes>;
     
 }
\ No newline at end of file
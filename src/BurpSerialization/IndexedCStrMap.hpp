@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CStrMap.hpp"
+#include "KeyIndex.hpp"
+
+namespace BurpSerialization
+{
+
+    // A CStrMap that looks up keys through a KeyIndex built at construction,
+    // for maps with enough choices that a linear scan shows up
+    template <class Type, size_t count, template <class> class Codes = CopiedCodes, class Key = const char *>
+    class IndexedCStrMap : public CStrMap<Type, count, Codes, Key>
+    {
+
+    public:
+
+        using Map = CStrMap<Type, count, Codes, Key>;
+
+        IndexedCStrMap(typename Map::Choices choices, typename Codes<typename Map::StatusCodes>::Argument statusCodes, typename Map::Value & value) :
+            Map(choices, statusCodes, value),
+            _index(choices, &Map::Choice::key)
+        {}
+
+    protected:
+
+        size_t _findKey(const char * key) const override {
+            return _index.find(this->_choices, &Map::Choice::key, key);
+        }
+
+    private:
+
+        const KeyIndex<count, Key> _index;
+
+    };
+
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <string.h>
+#include "Serialization.hpp"
+#ifdef BURP_NATIVE
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace BurpSerialization
+{
+
+    // Decodes JSON Lines, one record of the same schema per line, into
+    // an array of Record. The serialization's fields are bound to a
+    // scratch record, which is value initialized before each line and
+    // copied into the array after it as Array does with its elements, and
+    // every line is parsed into the one document. Lines are parsed in
+    // place, so strings that fields point to, as CStr does, stay in the
+    // input: it must outlive the records and can only be decoded once.
+    // Empty lines are skipped and a \r before the \n is ignored.
+    //
+    //     JsonLines<Device> lines(serialization, scratch, doc, {0, 1, 2});
+    //     auto count = lines.decode(buffer, length, devices, codes, maxDevices);
+    template <class Record>
+    class JsonLines
+    {
+
+    public:
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code invalidInput;
+            const BurpStatus::Status::Code noMemory;
+        };
+
+        JsonLines(Serialization & serialization, Record & scratch, JsonDocument & document, const StatusCodes statusCodes) :
+            _serialization(serialization),
+            _scratch(scratch),
+            _document(document),
+            _statusCodes(statusCodes)
+        {}
+
+        // Returns the number of records, at most capacity, with the code
+        // of each from the serialization or, for a line that is not JSON,
+        // invalidInput or noMemory and a value initialized record that
+        // the serialization has marked not present. Lines after the
+        // first capacity records are not read, count() them to size the
+        // arrays.
+        size_t decode(char * data, const size_t length, Record * records, BurpStatus::Status::Code * codes, const size_t capacity) {
+            auto pos = data;
+            auto end = data + length;
+            size_t count = 0;
+            size_t lineLength;
+            while (count < capacity) {
+                auto line = _next(pos, end, lineLength);
+                if (line == nullptr) break;
+                codes[count] = _decode(line, lineLength);
+                records[count] = _scratch;
+                count++;
+            }
+            return count;
+        }
+
+        // the number of records in the input, without parsing them
+        static size_t count(const char * data, const size_t length) {
+            auto pos = data;
+            auto end = data + length;
+            size_t count = 0;
+            size_t lineLength;
+            while (_next(pos, end, lineLength) != nullptr) {
+                count++;
+            }
+            return count;
+        }
+
+    private:
+
+        Serialization & _serialization;
+        Record & _scratch;
+        JsonDocument & _document;
+        const StatusCodes _statusCodes;
+
+        // the next line that is not empty and its length without the
+        // line ending, nullptr at the end
+        template <class Char>
+        static Char * _next(Char *& pos, Char * end, size_t & lineLength) {
+            while (pos < end) {
+                auto line = pos;
+                auto newline = static_cast<Char *>(memchr(line, '\n', end - line));
+                auto lineEnd = newline == nullptr ? end : newline;
+                pos = newline == nullptr ? end : newline + 1;
+                if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+                if (lineEnd > line) {
+                    lineLength = lineEnd - line;
+                    return line;
+                }
+            }
+            return nullptr;
+        }
+
+        BurpStatus::Status::Code _decode(char * line, const size_t lineLength) {
+            // nothing is left over from the last line, whatever the fields set
+            _scratch = Record();
+            auto error = deserializeJson(_document, line, lineLength);
+            if (error) {
+                _serialization.deserialize(JsonVariant());
+                return error == DeserializationError::NoMemory ? _statusCodes.noMemory : _statusCodes.invalidInput;
+            }
+            return _serialization.deserialize(_document.as<JsonVariant>());
+        }
+
+    };
+
+#ifdef BURP_NATIVE
+    // Decodes batches of JSON Lines on several decoders at once. The input
+    // is split at line boundaries into one run of about the same length
+    // per decoder, the first decoded on the calling thread and each of the
+    // others on a worker thread of its own. The workers are started once
+    // and kept for every batch until this is destroyed. Each decoder needs
+    // its own serialization, fields, scratch record and document, as
+    // fields keep state while deserializing. The records and codes are in
+    // input order and, as with JsonLines::decode, there are at most
+    // capacity of them.
+    //
+    //     JsonLinesWorkers<Device> workers({&lines0, &lines1, &lines2});
+    //     auto count = workers.decode(buffer, length, devices, codes, maxDevices);
+    template <class Record>
+    class JsonLinesWorkers
+    {
+
+    public:
+
+        using Decoders = std::vector<JsonLines<Record> *>;
+
+        explicit JsonLinesWorkers(const Decoders & decoders) :
+            _decoders(decoders),
+            _starts(decoders.size() + 1),
+            _offsets(decoders.size() + 1)
+        {
+#ifndef BURP_SERIALIZATION_ACCOUNTING
+            for (size_t run = 1; run < _decoders.size(); run++) {
+                _threads.emplace_back(&JsonLinesWorkers::_work, this, run);
+            }
+#endif
+        }
+
+        JsonLinesWorkers(const JsonLinesWorkers &) = delete;
+        JsonLinesWorkers & operator=(const JsonLinesWorkers &) = delete;
+
+        ~JsonLinesWorkers() {
+#ifndef BURP_SERIALIZATION_ACCOUNTING
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _start.notify_all();
+            for (auto & thread : _threads) {
+                thread.join();
+            }
+#endif
+        }
+
+        size_t decode(char * data, const size_t length, Record * records, BurpStatus::Status::Code * codes, const size_t capacity) {
+            auto runCount = _decoders.size();
+            if (runCount == 0) return 0;
+            _split(data, length);
+            _data = data;
+            _records = records;
+            _codes = codes;
+            _capacity = capacity;
+#ifdef BURP_SERIALIZATION_ACCOUNTING
+            // the accounting paths are shared, so the runs take turns
+            for (size_t run = 0; run < runCount; run++) {
+                _decodeRun(run);
+            }
+#else
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending = runCount - 1;
+                _batch++;
+            }
+            _start.notify_all();
+            _decodeRun(0);
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]() { return _pending == 0; });
+#endif
+            return _offsets[runCount] < capacity ? _offsets[runCount] : capacity;
+        }
+
+    private:
+
+        const Decoders _decoders;
+        // the current batch: the runs' bounds and where their records go
+        std::vector<size_t> _starts;
+        std::vector<size_t> _offsets;
+        char * _data = nullptr;
+        Record * _records = nullptr;
+        BurpStatus::Status::Code * _codes = nullptr;
+        size_t _capacity = 0;
+#ifndef BURP_SERIALIZATION_ACCOUNTING
+        // _batch counts the batches started, _pending the runs of the
+        // current one still on a worker
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        size_t _batch = 0;
+        size_t _pending = 0;
+        bool _stopping = false;
+
+        void _work(const size_t run) {
+            size_t batch = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                _start.wait(lock, [&]() { return _stopping || _batch != batch; });
+                if (_stopping) return;
+                batch = _batch;
+                lock.unlock();
+                _decodeRun(run);
+                lock.lock();
+                if (--_pending == 0) _done.notify_one();
+            }
+        }
+#endif
+
+        void _split(char * data, const size_t length) {
+            auto runCount = _decoders.size();
+            _starts[0] = 0;
+            _starts[runCount] = length;
+            for (size_t run = 1; run < runCount; run++) {
+                auto start = length * run / runCount;
+                if (start < _starts[run - 1]) start = _starts[run - 1];
+                auto newline = start == 0 ? nullptr : static_cast<char *>(memchr(data + start - 1, '\n', length - start + 1));
+                _starts[run] = start == 0 ? 0 : newline == nullptr ? length : newline - data + 1;
+            }
+            _offsets[0] = 0;
+            for (size_t run = 0; run < runCount; run++) {
+                _offsets[run + 1] = _offsets[run] + JsonLines<Record>::count(data + _starts[run], _starts[run + 1] - _starts[run]);
+            }
+        }
+
+        void _decodeRun(const size_t run) {
+            if (_offsets[run] >= _capacity) return;
+            auto runCapacity = _offsets[run + 1] < _capacity ? _offsets[run + 1] - _offsets[run] : _capacity - _offsets[run];
+            _decoders[run]->decode(_data + _starts[run], _starts[run + 1] - _starts[run], _records + _offsets[run], _codes + _offsets[run], runCapacity);
+        }
+
+    };
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "KeyIndex.hpp"
+
+namespace BurpSerialization
+{
+
+    uint32_t hashKey(const char * key, uint32_t hash) {
+        for (auto pos = key; *pos; pos++) {
+            hash ^= static_cast<uint8_t>(*pos);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    uint32_t hashKey(const FlashString * key, uint32_t hash) {
+        for (size_t index = 0; auto c = stringAt(key, index); index++) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    uint32_t hashBytes(const uint8_t * data, const size_t length, uint32_t hash) {
+        for (size_t index = 0; index < length; index++) {
+            hash ^= data[index];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <stdint.h>
+#include <stddef.h>
+#include "Flash.hpp"
+
+namespace BurpSerialization
+{
+
+    // 32 bit FNV-1a, pass a previous hash to continue it
+    constexpr uint32_t hashSeed = 2166136261u;
+    uint32_t hashKey(const char * key, uint32_t hash = hashSeed);
+    uint32_t hashKey(const FlashString * key, uint32_t hash = hashSeed);
+    uint32_t hashBytes(const uint8_t * data, const size_t length, uint32_t hash);
+
+    // the narrowest type that holds an index below count
+    template <size_t count>
+    using IndexType = typename std::conditional<count <= 0x100, uint8_t,
+        typename std::conditional<count <= 0x10000, uint16_t, size_t>::type>::type;
+
+    // Maps keys to their position in a fixed table of items. Built once
+    // at construction, lookups are a hash plus a binary search so cost
+    // does not grow linearly with the number of keys. The keys can be in
+    // RAM or flash, lookups are always for a key in RAM. Only hashes and
+    // positions are kept, so find is given the same table again to
+    // compare the keys.
+    template <size_t count, class Key = const char *>
+    class KeyIndex
+    {
+
+    public:
+
+        static constexpr size_t notFound = count;
+
+        template <class Item>
+        KeyIndex(const std::array<Item, count> & items, const Key Item::* key) {
+            std::array<uint32_t, count> hashes;
+            for (size_t index = 0; index < count; index++) {
+                hashes[index] = hashKey(items[index].*key);
+                _indices[index] = static_cast<Index>(index);
+            }
+            std::sort(_indices.begin(), _indices.end(), [&hashes](const Index a, const Index b) {
+                return hashes[a] < hashes[b];
+            });
+            for (size_t slot = 0; slot < count; slot++) {
+                _hashes[slot] = hashes[_indices[slot]];
+            }
+        }
+
+        template <class Item>
+        size_t find(const std::array<Item, count> & items, const Key Item::* key, const char * lookup) const {
+            auto hash = hashKey(lookup);
+            size_t slot = std::lower_bound(_hashes.begin(), _hashes.end(), hash) - _hashes.begin();
+            for (; slot < count && _hashes[slot] == hash; slot++) {
+                auto index = _indices[slot];
+                if (stringEquals(items[index].*key, lookup)) return index;
+            }
+            return notFound;
+        }
+
+    private:
+
+        using Index = IndexType<count>;
+
+        // sorted, with the position of each item in the same order
+        std::array<uint32_t, count> _hashes;
+        std::array<Index, count> _indices;
+
+    };
+
+}
\ No newline at end of file
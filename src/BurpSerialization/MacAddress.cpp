@@ -1,108 +1,318 @@
+#include <string.h>
 #include "MacAddress.hpp"
 
 namespace BurpSerialization
 {
-    char hexDigit(uint8_t value) {
-        if (value < 10) {
-            return '0' + value;
+
+    namespace
+    {
+
+        // the upper case text of every byte, two characters each
+        const char hexPairs[] PROGMEM =
+        "000102030405060708090A0B0C0D0E0F"
+        "101112131415161718191A1B1C1D1E1F"
+        "202122232425262728292A2B2C2D2E2F"
+        "303132333435363738393A3B3C3D3E3F"
+        "404142434445464748494A4B4C4D4E4F"
+        "505152535455565758595A5B5C5D5E5F"
+        "606162636465666768696A6B6C6D6E6F"
+        "707172737475767778797A7B7C7D7E7F"
+        "808182838485868788898A8B8C8D8E8F"
+        "909192939495969798999A9B9C9D9E9F"
+        "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+        "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+        "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+        "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+        "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+        "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+        // the value of each hex digit by character, 0xff for the rest
+        const uint8_t nibbles[256] PROGMEM = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+        };
+
+        uint8_t nibble(const char digit) {
+            uint8_t value;
+            flashRead(&value, &nibbles[static_cast<uint8_t>(digit)], 1);
+            return value;
         }
-        return 'A' + (value - 10);
-    }
 
-    int8_t hexValue(char digit) {
-        if (digit >= '0' && digit <= '9') {
-            return digit - '0';
+        // one character at a time, for anything the canonical form does
+        // not cover, such as single digit bytes
+        MacAddressText parseByte(const char *& pos, uint8_t & dest) {
+            uint16_t value = 0;
+            auto start = pos;
+            auto digit = nibble(*pos);
+            while (digit != 0xff) {
+                value *= 0x10;
+                value += digit;
+                pos++;
+                digit = nibble(*pos);
+                if (value > 255) return MacAddressText::outOfRange;
+            }
+            if (pos == start) return MacAddressText::missingField;
+            dest = value;
+            return MacAddressText::ok;
         }
-        if (digit >= 'a' && digit <= 'f') {
-            return 10 + digit - 'a';
+
+        MacAddressText parseBytewise(const char * src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT]) {
+            auto pos = src;
+            char separator = ':';
+            for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
+                auto result = parseByte(pos, dest[field]);
+                if (result != MacAddressText::ok) return result;
+                if (field == 0) {
+                    if (*pos == ':') separator = ':';
+                    else if (*pos == '-') separator = '-';
+                    else return MacAddressText::invalidCharacter;
+                }
+                else if (field < MAC_ADDRESS_BYTE_COUNT - 1) {
+                    if (*pos != separator) return MacAddressText::invalidSeparator;
+                } else {
+                    if (*pos != 0) return MacAddressText::excessCharacters;
+                }
+                pos++;
+            }
+            return MacAddressText::ok;
         }
-        if (digit >= 'A' && digit <= 'F') {
-            return 10 + digit - 'A';
+
+        template <class StatusCodes>
+        BurpStatus::Status::Code macAddressCode(const MacAddressText result, const StatusCodes & statusCodes) {
+            switch (result) {
+                case MacAddressText::ok: return statusCodes.ok;
+                case MacAddressText::invalidCharacter: return statusCodes.invalidCharacter;
+                case MacAddressText::invalidSeparator: return statusCodes.invalidSeparator;
+                case MacAddressText::outOfRange: return statusCodes.outOfRange;
+                case MacAddressText::missingField: return statusCodes.missingField;
+                default: return statusCodes.excessCharacters;
+            }
         }
-        return -1;
-    }
 
-    char * uint8ToHex(uint8_t src, char * dest) {
-        uint8_t ones = src % 0x10;
-        uint8_t sixteens = src - ones;
-        *dest = hexDigit(sixteens / 0x10);
-        dest++;
-        *dest = hexDigit(ones);
-        dest++;
-        return dest;
     }
 
-    BurpStatus::Status::Code hexToUInt8(const char *& pos, uint8_t & dest, MacAddress::StatusCodes statusCodes) {
-        uint16_t value = 0;
-        auto start = pos;
-        int8_t digit = hexValue(*pos);
-        while (digit > -1) {
-            value *= 0x10;
-            value += digit;
-            pos++;
-            digit = hexValue(*pos);
-            if (value > 255) return statusCodes.outOfRange;
+    MacAddressText parseMacAddress(const char * src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT]) {
+        // the canonical form, two digits a byte and the same separator
+        // throughout, decoded without a branch per character
+        if (strnlen(src, MAC_ADDRESS_LENGTH + 1) == MAC_ADDRESS_LENGTH) {
+            auto separator = src[2];
+            bool canonical = separator == ':' || separator == '-';
+            uint8_t invalid = 0;
+            uint8_t bytes[MAC_ADDRESS_BYTE_COUNT];
+            for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
+                auto pos = src + field * 3;
+                if (field > 0) canonical &= pos[-1] == separator;
+                auto high = nibble(pos[0]);
+                auto low = nibble(pos[1]);
+                invalid |= high | low;
+                bytes[field] = (high << 4) | low;
+            }
+            if (canonical && !(invalid & 0x10)) {
+                memcpy(dest, bytes, MAC_ADDRESS_BYTE_COUNT);
+                return MacAddressText::ok;
+            }
         }
-        if (pos == start) return statusCodes.missingField;
-        dest = value;
-        return statusCodes.ok;
+        return parseBytewise(src, dest);
     }
 
-    BurpStatus::Status::Code strToMacAddress(const char * src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT], MacAddress::StatusCodes statusCodes) {
-        auto pos = src;
-        char separator = ':';
+    char * formatMacAddress(const uint8_t src[MAC_ADDRESS_BYTE_COUNT], char * dest) {
+        auto pos = dest;
         for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
-            auto code = hexToUInt8(pos, dest[field], statusCodes);
-            if (code != statusCodes.ok) return code;
-            if (field == 0) {
-                if (*pos == ':') separator = ':';
-                else if (*pos == '-') separator = '-';
-                else return statusCodes.invalidCharacter;
-            }
-            else if (field < MAC_ADDRESS_BYTE_COUNT - 1) {
-                if (*pos != separator) return statusCodes.invalidSeparator;
-            } else {
-                if (*pos != 0) return statusCodes.excessCharacters;
-            }
-            pos++;
+            if (field > 0) *pos++ = ':';
+            flashRead(pos, &hexPairs[src[field] * 2], 2);
+            pos += 2;
         }
-        return statusCodes.ok;
+        *pos = 0;
+        return pos;
     }
 
-    MacAddress::MacAddress(const StatusCodes statusCodes, Value & value) :
+    template <template <class> class Codes>
+    BasicMacAddress<Codes>::BasicMacAddress(typename Codes<StatusCodes>::Argument statusCodes, Value & value, const MacAddressForm form) :
         _statusCodes(statusCodes),
-        _value(value)
+        _value(value),
+        _form(form),
+        _byteField(*this)
     {}
 
-    BurpStatus::Status::Code MacAddress::deserialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicMacAddress<Codes>::deserialize(const JsonVariant & serialized) const {
         _value.isNull = true;
         if (serialized.isNull()) {
-            return _statusCodes.notPresent;
+            return _statusCodes.get(&StatusCodes::notPresent);
         }
         if (serialized.is<const char *>()) {
-            auto code = strToMacAddress(serialized.as<const char *>(), _value.value, _statusCodes);
-            if (code != _statusCodes.ok) return code;
+            auto result = parseMacAddress(serialized.as<const char *>(), _value.value);
+            if (result != MacAddressText::ok) return macAddressCode(result, *_statusCodes);
+            _value.isNull = false;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+        if (serialized.is<JsonArray>()) {
+            beginArray();
+            for (auto byte : serialized.as<JsonArray>()) {
+                childDeserialized(_byteField.deserialize(byte));
+            }
+            return endContainer();
+        }
+        if (serialized.is<uint64_t>()) {
+            auto integer = serialized.as<uint64_t>();
+            if (integer > MAC_ADDRESS_MAX_INTEGER) return _statusCodes.get(&StatusCodes::outOfRange);
+            macAddressFromInteger(integer, _value.value);
             _value.isNull = false;
-            return _statusCodes.ok;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+        if (serialized.is<int64_t>()) {
+            return _statusCodes.get(&StatusCodes::outOfRange);
+        }
+        return _statusCodes.get(&StatusCodes::wrongType);
+    }
+
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicMacAddress<Codes>::Byte::deserialize(const JsonVariant & serialized) const {
+        _address._byte = 0;
+        if (serialized.is<uint8_t>()) {
+            _address._byte = serialized.as<uint8_t>();
+            return _address._statusCodes.get(&StatusCodes::ok);
+        }
+        if (serialized.is<int64_t>() || serialized.is<uint64_t>()) {
+            return _address._statusCodes.get(&StatusCodes::outOfRange);
+        }
+        return _address._statusCodes.get(&StatusCodes::wrongType);
+    }
+
+    template <template <class> class Codes>
+    bool BasicMacAddress<Codes>::beginArray() const {
+        _value.isNull = true;
+        _count = 0;
+        _code = _statusCodes.get(&StatusCodes::ok);
+        return true;
+    }
+
+    template <template <class> class Codes>
+    const Field * BasicMacAddress<Codes>::element() const {
+        return &_byteField;
+    }
+
+    template <template <class> class Codes>
+    void BasicMacAddress<Codes>::childDeserialized(const BurpStatus::Status::Code code) const {
+        auto index = _count++;
+        // keep counting past the first error so that too many bytes wins
+        if (index >= MAC_ADDRESS_BYTE_COUNT || _code != _statusCodes.get(&StatusCodes::ok)) return;
+        if (code != _statusCodes.get(&StatusCodes::ok)) {
+            _code = code;
+            return;
+        }
+        _value.value[index] = _byte;
+    }
+
+    // the same codes as the text form for too few or too many bytes
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicMacAddress<Codes>::endContainer() const {
+        if (_count > MAC_ADDRESS_BYTE_COUNT) {
+            return _statusCodes.get(&StatusCodes::excessCharacters);
+        }
+        if (_code != _statusCodes.get(&StatusCodes::ok)) {
+            return _code;
         }
-        return _statusCodes.wrongType;
+        if (_count < MAC_ADDRESS_BYTE_COUNT) {
+            return _statusCodes.get(&StatusCodes::missingField);
+        }
+        _value.isNull = false;
+        return _statusCodes.get(&StatusCodes::ok);
     }
 
-    bool MacAddress::serialize(const JsonVariant & serialized) const {
+    template <template <class> class Codes>
+    bool BasicMacAddress<Codes>::serialize(const JsonVariant & serialized) const {
         if (_value.isNull) {
             serialized.clear();
             return true;
         }
-        char szMacAddress[MAC_ADDRESS_BYTE_COUNT * 3] = {};
-        char * pos = szMacAddress;
-        for (uint8_t field = 0; field < MAC_ADDRESS_BYTE_COUNT; field++) {
-            if (field > 0) {
-                *pos = ':';
-                pos++;
+        if (_form == MacAddressForm::integer) {
+            return serialized.set(macAddressToInteger(_value.value));
+        }
+        if (_form == MacAddressForm::bytes) {
+            auto jsonArray = serialized.to<JsonArray>();
+            for (auto byte : _value.value) {
+                if (!jsonArray.add(byte)) return false;
             }
-            pos = uint8ToHex(_value.value[field], pos);
+            return true;
         }
+        char szMacAddress[MAC_ADDRESS_LENGTH + 1];
+        formatMacAddress(_value.value, szMacAddress);
         return serialized.set(szMacAddress);
     }
 
+    template <template <class> class Codes>
+    bool BasicMacAddress<Codes>::write(Writer & writer) const {
+        if (_value.isNull) {
+            return writer.null();
+        }
+        if (_form == MacAddressForm::integer) {
+            return writer.unsignedInteger(macAddressToInteger(_value.value));
+        }
+        // bin is already the compact MessagePack form
+        if (writer.format() == Writer::Format::msgPack) {
+            return writer.binary(_value.value, MAC_ADDRESS_BYTE_COUNT);
+        }
+        if (_form == MacAddressForm::bytes) {
+            if (!writer.beginArray(MAC_ADDRESS_BYTE_COUNT)) return false;
+            for (auto byte : _value.value) {
+                if (!writer.unsignedInteger(byte)) return false;
+            }
+            return writer.endArray();
+        }
+        char szMacAddress[MAC_ADDRESS_LENGTH + 1];
+        auto end = formatMacAddress(_value.value, szMacAddress);
+        return writer.string(szMacAddress, end - szMacAddress);
+    }
+
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicMacAddress<Codes>::deserializeBinary(const uint8_t * data, const size_t length) const {
+        _value.isNull = true;
+        if (length != MAC_ADDRESS_BYTE_COUNT) {
+            return _statusCodes.get(&StatusCodes::wrongType);
+        }
+        memcpy(_value.value, data, MAC_ADDRESS_BYTE_COUNT);
+        _value.isNull = false;
+        return _statusCodes.get(&StatusCodes::ok);
+    }
+
+    template <template <class> class Codes>
+    bool BasicMacAddress<Codes>::isNull() const {
+        return _value.isNull;
+    }
+
+    template <template <class> class Codes>
+    bool BasicMacAddress<Codes>::encode(BinaryEncoder & encoder) const {
+        return encoder.write(_value.value, MAC_ADDRESS_BYTE_COUNT) == MAC_ADDRESS_BYTE_COUNT;
+    }
+
+    template <template <class> class Codes>
+    BurpStatus::Status::Code BasicMacAddress<Codes>::decode(BinaryDecoder & decoder) const {
+        auto data = decoder.read(MAC_ADDRESS_BYTE_COUNT);
+        if (data == nullptr) return deserialize(JsonVariant());
+        return deserializeBinary(data, MAC_ADDRESS_BYTE_COUNT);
+    }
+
+    template <template <class> class Codes>
+    uint32_t BasicMacAddress<Codes>::fingerprint(const uint32_t hash) const {
+        return hashKey("mac", hash);
+    }
+
+    template class BasicMacAddress<CopiedCodes>;
+    template class BasicMacAddress<SharedCodes>;
+
 }
\ No newline at end of file
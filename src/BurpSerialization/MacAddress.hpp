@@ -1,12 +1,62 @@
 #pragma once
 
 #include "Field.hpp"
+#include "Codes.hpp"
 
 namespace BurpSerialization
 {
     constexpr size_t MAC_ADDRESS_BYTE_COUNT = 6;
+    constexpr size_t MAC_ADDRESS_LENGTH = MAC_ADDRESS_BYTE_COUNT * 3 - 1;
 
-    class MacAddress : public Field
+    // the MAC address parse results, mapped onto each field's codes
+    enum class MacAddressText {
+        ok,
+        invalidCharacter,
+        invalidSeparator,
+        outOfRange,
+        missingField,
+        excessCharacters
+    };
+
+    // Decodes the canonical form, 12:34:56:78:9A:BC or with hyphens,
+    // through a table of digit values. Anything else, such as single
+    // digit bytes, goes character by character to find the code.
+    MacAddressText parseMacAddress(const char * src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT]);
+    // writes the upper case colon form into MAC_ADDRESS_LENGTH + 1
+    // bytes, null terminated, and returns the end of the text
+    char * formatMacAddress(const uint8_t src[MAC_ADDRESS_BYTE_COUNT], char * dest);
+
+    constexpr uint64_t MAC_ADDRESS_MAX_INTEGER = 0xffffffffffffull;
+
+    // The bytes are already in network order, as sockaddr_ll and ifreq
+    // take them. These convert to and from the 48 bit integer form,
+    // 12:34:56:78:9A:BC is 0x123456789abc.
+    inline uint64_t macAddressToInteger(const uint8_t src[MAC_ADDRESS_BYTE_COUNT]) {
+        uint64_t integer = 0;
+        for (size_t index = 0; index < MAC_ADDRESS_BYTE_COUNT; index++) {
+            integer = (integer << 8) | src[index];
+        }
+        return integer;
+    }
+
+    inline void macAddressFromInteger(uint64_t src, uint8_t dest[MAC_ADDRESS_BYTE_COUNT]) {
+        for (size_t index = MAC_ADDRESS_BYTE_COUNT; index > 0; index--) {
+            dest[index - 1] = static_cast<uint8_t>(src);
+            src >>= 8;
+        }
+    }
+
+    // how serialize and write give the value: the colon separated text,
+    // an array of the 6 bytes or the 48 bit integer. All three are
+    // accepted by deserialize whatever the form.
+    enum class MacAddressForm {
+        text,
+        bytes,
+        integer
+    };
+
+    template <template <class> class Codes = CopiedCodes>
+    class BasicMacAddress : public Field
     {
 
     public:
@@ -27,16 +77,75 @@ namespace BurpSerialization
             const BurpStatus::Status::Code excessCharacters;
         };
 
-        MacAddress(const StatusCodes statusCodes, Value & value);
+        // for values in the given form
+        static constexpr Capacity capacity(const MacAddressForm form = MacAddressForm::text) {
+            return form == MacAddressForm::text ?
+                Capacity{0, JSON_STRING_SIZE(MAC_ADDRESS_LENGTH), JSON_STRING_SIZE(MAC_ADDRESS_LENGTH)} :
+                form == MacAddressForm::bytes ?
+                Capacity{JSON_ARRAY_SIZE(MAC_ADDRESS_BYTE_COUNT), 0, 0} :
+                Capacity{0, 0, 0};
+        }
+
+        BasicMacAddress(typename Codes<StatusCodes>::Argument statusCodes, Value & value, const MacAddressForm form = MacAddressForm::text);
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
         bool serialize(const JsonVariant & serialized) const override;
+        bool write(Writer & writer) const override;
+        BurpStatus::Status::Code deserializeBinary(const uint8_t * data, const size_t length) const override;
+        bool isNull() const override;
+        bool encode(BinaryEncoder & encoder) const override;
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override;
+        uint32_t fingerprint(const uint32_t hash) const override;
 
-    private:
+        bool beginArray() const override;
+        const Field * element() const override;
+        void childDeserialized(const BurpStatus::Status::Code code) const override;
+        BurpStatus::Status::Code endContainer() const override;
 
-        const StatusCodes _statusCodes;
+    protected:
+
+        const Codes<StatusCodes> _statusCodes;
         Value & _value;
+        const MacAddressForm _form;
+
+    private:
+
+        // each element of the bytes form
+        class Byte : public Field
+        {
+
+        public:
+
+            Byte(const BasicMacAddress & address) :
+                _address(address)
+            {}
+
+            BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
+
+            bool serialize(const JsonVariant &) const override {
+                return false;
+            }
+
+        private:
+
+            const BasicMacAddress & _address;
+
+        };
+
+        const Byte _byteField;
+
+        // element by element deserialization state
+        mutable size_t _count;
+        mutable BurpStatus::Status::Code _code;
+        mutable uint8_t _byte;
 
     };
+
+    using MacAddress = BasicMacAddress<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedMacAddress = BasicMacAddress<SharedCodes>;
+
+    extern template class BasicMacAddress<CopiedCodes>;
+    extern template class BasicMacAddress<SharedCodes>;
     
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "MemoryAccounting.hpp"
+
+#ifdef BURP_SERIALIZATION_ACCOUNTING
+
+#include <array>
+#include <cstring>
+
+namespace BurpSerialization
+{
+
+    namespace {
+
+        std::array<MemoryAccounting::Usage, MemoryAccounting::maxPaths> usages;
+        size_t usageCount = 0;
+        size_t droppedCount = 0;
+        char currentPath[MemoryAccounting::maxPathLength] = "";
+        size_t currentLength = 0;
+
+        size_t countSlots(const JsonVariant & variant) {
+            size_t slots = 0;
+            if (variant.is<JsonObject>()) {
+                for (JsonPair member : variant.as<JsonObject>()) {
+                    slots += 1 + countSlots(member.value());
+                }
+            } else if (variant.is<JsonArray>()) {
+                for (JsonVariant element : variant.as<JsonArray>()) {
+                    slots += 1 + countSlots(element);
+                }
+            }
+            return slots;
+        }
+
+        // JsonVariant::memoryUsage() covers the subtree, whatever is not
+        // a slot is a copied string
+        MemoryAccounting::Measure measure(const JsonVariant & variant) {
+            auto bytes = variant.memoryUsage();
+            auto slotBytes = countSlots(variant) * JSON_OBJECT_SIZE(1);
+            return {bytes, bytes > slotBytes ? bytes - slotBytes : 0};
+        }
+
+        MemoryAccounting::Usage * findUsage(const char * path) {
+            for (size_t index = 0; index < usageCount; index++) {
+                if (strcmp(usages[index].path, path) == 0) return &usages[index];
+            }
+            return nullptr;
+        }
+
+        void record(const MemoryAccounting::Direction direction, const MemoryAccounting::Measure & measured) {
+            auto usage = findUsage(currentPath);
+            if (usage == nullptr) {
+                if (usageCount == MemoryAccounting::maxPaths) {
+                    droppedCount++;
+                    return;
+                }
+                usage = &usages[usageCount++];
+                *usage = {};
+                strcpy(usage->path, currentPath);
+            }
+            if (direction == MemoryAccounting::Direction::deserialize) {
+                usage->deserialized = measured;
+            } else {
+                usage->serialized = measured;
+            }
+            if (measured.bytes > usage->highWater) usage->highWater = measured.bytes;
+        }
+
+        // appends name to the current path, paths that are too long are
+        // cut short rather than dropped
+        template <class Name>
+        void enter(const Name name) {
+            if (currentLength > 0 && stringAt(name, 0) && currentLength + 1 < MemoryAccounting::maxPathLength) currentPath[currentLength++] = '.';
+            for (size_t index = 0; stringAt(name, index) && currentLength + 1 < MemoryAccounting::maxPathLength; index++) {
+                currentPath[currentLength++] = stringAt(name, index);
+            }
+            currentPath[currentLength] = '\0';
+        }
+
+    }
+
+    MemoryAccounting::Scope::Scope(const char * name, const JsonVariant & variant, const Direction direction) :
+        _variant(variant),
+        _direction(direction),
+        _parentLength(currentLength)
+    {
+        enter(name);
+        if (_direction == Direction::deserialize) record(_direction, measure(_variant));
+    }
+
+    MemoryAccounting::Scope::Scope(const FlashString * name, const JsonVariant & variant, const Direction direction) :
+        _variant(variant),
+        _direction(direction),
+        _parentLength(currentLength)
+    {
+        enter(name);
+        if (_direction == Direction::deserialize) record(_direction, measure(_variant));
+    }
+
+    MemoryAccounting::Scope::~Scope() {
+        if (_direction == Direction::serialize) record(_direction, measure(_variant));
+        currentLength = _parentLength;
+        currentPath[currentLength] = '\0';
+    }
+
+    void MemoryAccounting::reset() {
+        usageCount = 0;
+        droppedCount = 0;
+    }
+
+    size_t MemoryAccounting::count() {
+        return usageCount;
+    }
+
+    const MemoryAccounting::Usage & MemoryAccounting::usage(const size_t index) {
+        return usages[index];
+    }
+
+    const MemoryAccounting::Usage * MemoryAccounting::find(const char * path) {
+        return findUsage(path);
+    }
+
+    size_t MemoryAccounting::dropped() {
+        return droppedCount;
+    }
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include "Flash.hpp"
+
+namespace BurpSerialization
+{
+
+    // Records how much of the JsonDocument pool each Object path uses, to
+    // find the subtree that filled a document. Build with
+    //
+    //     -D BURP_SERIALIZATION_ACCOUNTING
+    //
+    // to enable. Otherwise Scope is empty and compiles to nothing.
+    class MemoryAccounting
+    {
+
+    public:
+
+        enum class Direction {
+            deserialize,
+            serialize
+        };
+
+#ifdef BURP_SERIALIZATION_ACCOUNTING
+
+        static constexpr size_t maxPaths = 32;
+        static constexpr size_t maxPathLength = 64;
+
+        struct Measure {
+            // the subtree, slots and copied strings
+            size_t bytes;
+            // the part of bytes used by strings copied into the pool, keys
+            // included
+            size_t strings;
+        };
+
+        struct Usage {
+            // dot separated Object path, "network.ip", empty for the root
+            char path[maxPathLength];
+            // the last deserialize source and the last serialize result
+            Measure deserialized;
+            Measure serialized;
+            // the most bytes seen in either direction since reset()
+            size_t highWater;
+        };
+
+        // Measures the field at `name` in the current path. For
+        // deserialize the source is measured straight away, for serialize
+        // the result is measured when the scope ends.
+        class Scope {
+
+        public:
+
+            Scope(const char * name, const JsonVariant & variant, const Direction direction);
+            Scope(const FlashString * name, const JsonVariant & variant, const Direction direction);
+            ~Scope();
+
+        private:
+
+            const JsonVariant _variant;
+            const Direction _direction;
+            const size_t _parentLength;
+
+        };
+
+        static void reset();
+        static size_t count();
+        static const Usage & usage(const size_t index);
+        // nullptr if the path has not been seen
+        static const Usage * find(const char * path);
+        // paths that did not fit in maxPaths
+        static size_t dropped();
+
+#else
+
+        class Scope {
+
+        public:
+
+            Scope(const char *, const JsonVariant &, const Direction) {}
+            Scope(const FlashString *, const JsonVariant &, const Direction) {}
+
+        };
+
+#endif
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include <string.h>
+#include "MsgPackParser.hpp"
+
+namespace BurpSerialization
+{
+
+    // bytes following a type byte, 0 for types without any or not supported
+    uint8_t msgPackHeaderSize(const uint8_t type) {
+        switch (type) {
+            case 0xc4: case 0xcc: case 0xd0: case 0xd9:
+                return 1;
+            case 0xc5: case 0xcd: case 0xd1: case 0xda: case 0xdc: case 0xde:
+                return 2;
+            case 0xc6: case 0xca: case 0xce: case 0xd2: case 0xdb: case 0xdd: case 0xdf:
+                return 4;
+            case 0xcb: case 0xcf: case 0xd3:
+                return 8;
+        }
+        return 0;
+    }
+
+    bool isMsgPackString(const uint8_t type) {
+        return (type >= 0xa0 && type <= 0xbf) || (type >= 0xd9 && type <= 0xdb);
+    }
+
+    MsgPackParser::MsgPackParser(const Field & root, char * buffer, const size_t size, const StatusCodes statusCodes) :
+        _root(root),
+        _buffer(buffer),
+        _size(size),
+        _statusCodes(statusCodes)
+    {
+        begin();
+    }
+
+    void MsgPackParser::begin() {
+        _depth = 0;
+        _state = State::type;
+        _error = _statusCodes.ok;
+        _result = _statusCodes.ok;
+        _target = nullptr;
+        _used = 0;
+        _tokenLength = 0;
+        _header = 0;
+        _type = 0;
+        _need = 0;
+        _remaining = 0;
+        _isKey = false;
+        _copying = false;
+    }
+
+    BurpStatus::Status::Code MsgPackParser::write(const uint8_t * data, const size_t length) {
+        for (size_t index = 0; index < length && _state != State::failed; index++) {
+            _feed(data[index]);
+        }
+        return _error;
+    }
+
+    BurpStatus::Status::Code MsgPackParser::end() {
+        if (_state == State::failed) {
+            return _error;
+        }
+        if (_state != State::done) {
+            return _statusCodes.incomplete;
+        }
+        return _result;
+    }
+
+    void MsgPackParser::_feed(const uint8_t c) {
+        switch (_state) {
+            case State::type:
+                _type = c;
+                _isKey = _depth > 0 && _frames[_depth - 1].keyNext;
+                if (_isKey) {
+                    // only string keys can name a member
+                    if (!isMsgPackString(c)) return _fail(_statusCodes.invalidInput);
+                } else {
+                    _startValue();
+                }
+                if (c <= 0x7f || c >= 0xe0 || c == 0xc0 || c == 0xc2 || c == 0xc3) return _scalar();
+                if (c <= 0x8f) return _open(false, c & 0x0f);
+                if (c <= 0x9f) return _open(true, c & 0x0f);
+                if (c <= 0xbf) return _startPayload(c & 0x1f);
+                _need = msgPackHeaderSize(c);
+                if (_need == 0) return _fail(_statusCodes.invalidInput);
+                _header = 0;
+                _state = State::header;
+                return;
+            case State::header:
+                _header = (_header << 8) | c;
+                _need--;
+                if (_need == 0) _endHeader();
+                return;
+            case State::payload:
+                if (_copying) {
+                    _buffer[_used + _tokenLength] = static_cast<char>(c);
+                }
+                _tokenLength++;
+                _remaining--;
+                if (_remaining == 0) _endPayload();
+                return;
+            case State::done:
+                return _fail(_statusCodes.invalidInput);
+            case State::failed:
+                return;
+        }
+    }
+
+    void MsgPackParser::_startValue() {
+        if (_depth == 0) {
+            _target = &_root;
+        } else if (_frames[_depth - 1].isArray) {
+            auto parent = _frames[_depth - 1].field;
+            _target = parent == nullptr ? nullptr : parent->element();
+        }
+        // map values have their target set by the key
+    }
+
+    void MsgPackParser::_endHeader() {
+        switch (_type) {
+            case 0xc4: case 0xc5: case 0xc6:
+            case 0xd9: case 0xda: case 0xdb:
+                return _startPayload(static_cast<uint32_t>(_header));
+            case 0xdc: case 0xdd:
+                return _open(true, static_cast<uint32_t>(_header));
+            case 0xde: case 0xdf:
+                return _open(false, static_cast<uint32_t>(_header));
+        }
+        _scalar();
+    }
+
+    void MsgPackParser::_startPayload(const uint32_t length) {
+        _copying = _isKey ? _frames[_depth - 1].field != nullptr : _target != nullptr;
+        // room for the terminator
+        if (_copying && (length >= _size || _used > _size - length - 1)) {
+            return _fail(_statusCodes.noMemory);
+        }
+        _tokenLength = 0;
+        _remaining = length;
+        _state = State::payload;
+        if (length == 0) _endPayload();
+    }
+
+    void MsgPackParser::_endPayload() {
+        if (_isKey) {
+            auto & frame = _frames[_depth - 1];
+            _target = nullptr;
+            if (_copying) {
+                _buffer[_used + _tokenLength] = 0;
+                _target = frame.field->member(_buffer + _used);
+            }
+            // keys are only needed until the member is found
+            frame.keyNext = false;
+            _state = State::type;
+            return;
+        }
+        if (_copying) {
+            auto data = _buffer + _used;
+            if (isMsgPackString(_type)) {
+                data[_tokenLength] = 0;
+                _token.set(static_cast<const char *>(data));
+                _report(_target->deserialize(_token.as<JsonVariant>()));
+                _used += _tokenLength + 1;
+            } else {
+                _report(_target->deserializeBinary(reinterpret_cast<const uint8_t *>(data), _tokenLength));
+            }
+        }
+        _endValue();
+    }
+
+    void MsgPackParser::_scalar() {
+        if (_target != nullptr) {
+            switch (_type) {
+                case 0xc0:
+                    _token.clear();
+                    break;
+                case 0xc2:
+                case 0xc3:
+                    _token.set(_type == 0xc3);
+                    break;
+                case 0xca: {
+                    auto bits = static_cast<uint32_t>(_header);
+                    float value;
+                    memcpy(&value, &bits, sizeof(value));
+                    _token.set(value);
+                    break;
+                }
+                case 0xcb: {
+                    double value;
+                    memcpy(&value, &_header, sizeof(value));
+                    _token.set(value);
+                    break;
+                }
+                case 0xcc: case 0xcd: case 0xce: case 0xcf:
+                    _token.set(static_cast<JsonUInt>(_header));
+                    break;
+                case 0xd0:
+                    _token.set(static_cast<JsonInteger>(static_cast<int8_t>(_header)));
+                    break;
+                case 0xd1:
+                    _token.set(static_cast<JsonInteger>(static_cast<int16_t>(_header)));
+                    break;
+                case 0xd2:
+                    _token.set(static_cast<JsonInteger>(static_cast<int32_t>(_header)));
+                    break;
+                case 0xd3:
+                    _token.set(static_cast<JsonInteger>(static_cast<int64_t>(_header)));
+                    break;
+                default:
+                    // fixints
+                    if (_type <= 0x7f) {
+                        _token.set(static_cast<JsonUInt>(_type));
+                    } else {
+                        _token.set(static_cast<JsonInteger>(static_cast<int8_t>(_type)));
+                    }
+            }
+            _report(_target->deserialize(_token.as<JsonVariant>()));
+        }
+        _endValue();
+    }
+
+    void MsgPackParser::_open(const bool isArray, const uint32_t count) {
+        if (_depth == maxDepth) return _fail(_statusCodes.tooDeep);
+        auto field = _target;
+        if (field != nullptr) {
+            auto accepted = isArray ? field->beginArray() : field->beginObject();
+            if (!accepted) {
+                // leaves reject containers with their usual wrong type code
+                if (isArray) {
+                    _token.to<JsonArray>();
+                } else {
+                    _token.to<JsonObject>();
+                }
+                _report(field->deserialize(_token.as<JsonVariant>()));
+                field = nullptr;
+            }
+        }
+        _frames[_depth] = {field, count, isArray, !isArray};
+        _depth++;
+        _state = State::type;
+        if (count == 0) {
+            _close();
+            _endValue();
+        }
+    }
+
+    void MsgPackParser::_close() {
+        _depth--;
+        auto field = _frames[_depth].field;
+        if (field != nullptr) {
+            _report(field->endContainer());
+        }
+    }
+
+    // count the value against its container, closing containers as they fill
+    void MsgPackParser::_endValue() {
+        while (_depth > 0) {
+            auto & frame = _frames[_depth - 1];
+            frame.keyNext = !frame.isArray;
+            frame.remaining--;
+            if (frame.remaining > 0) {
+                _state = State::type;
+                return;
+            }
+            _close();
+        }
+        _state = State::done;
+    }
+
+    void MsgPackParser::_report(const BurpStatus::Status::Code code) {
+        if (_depth == 0) {
+            _result = code;
+            return;
+        }
+        auto parent = _frames[_depth - 1].field;
+        if (parent != nullptr) {
+            parent->childDeserialized(code);
+        }
+    }
+
+    void MsgPackParser::_fail(const BurpStatus::Status::Code code) {
+        _error = code;
+        _state = State::failed;
+    }
+
+}
\ No newline at end of file
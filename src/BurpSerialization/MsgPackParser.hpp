@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include "Field.hpp"
+
+namespace BurpSerialization
+{
+
+    // Push parser for MessagePack, the binary counterpart of Parser: it
+    // feeds the same Field tree through the same incremental hooks and
+    // keeps strings, null terminated, in the supplied buffer. bin values
+    // go to Field::deserializeBinary. Extension types are not supported.
+    class MsgPackParser
+    {
+
+    public:
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code incomplete;
+            const BurpStatus::Status::Code invalidInput;
+            const BurpStatus::Status::Code tooDeep;
+            const BurpStatus::Status::Code noMemory;
+        };
+
+        static constexpr size_t maxDepth = 16;
+
+        MsgPackParser(const Field & root, char * buffer, const size_t size, const StatusCodes statusCodes);
+
+        // start a new document, invalidates strings from the last one
+        void begin();
+        // returns ok or the parser error, errors are sticky until begin
+        BurpStatus::Status::Code write(const uint8_t * data, const size_t length);
+        // returns the parser error, incomplete or the code from the root field
+        BurpStatus::Status::Code end();
+
+    private:
+
+        enum class State : uint8_t {
+            type,
+            header,  // the big endian length or value after the type
+            payload, // string or bin bytes
+            done,
+            failed
+        };
+
+        struct Frame {
+            const Field * field; // nullptr when skipping the container
+            uint32_t remaining;  // elements, or members for a map
+            bool isArray;
+            bool keyNext;
+        };
+
+        const Field & _root;
+        char * const _buffer;
+        const size_t _size;
+        const StatusCodes _statusCodes;
+        StaticJsonDocument<16> _token;
+        std::array<Frame, maxDepth> _frames;
+        size_t _depth;
+        State _state;
+        BurpStatus::Status::Code _error;
+        BurpStatus::Status::Code _result;
+        const Field * _target;
+        size_t _used;
+        size_t _tokenLength;
+        uint64_t _header;
+        uint8_t _type;
+        uint8_t _need;
+        uint32_t _remaining;
+        bool _isKey;
+        bool _copying;
+
+        void _feed(const uint8_t c);
+        void _startValue();
+        void _endHeader();
+        void _startPayload(const uint32_t length);
+        void _endPayload();
+        void _scalar();
+        void _open(const bool isArray, const uint32_t count);
+        void _close();
+        void _endValue();
+        void _report(const BurpStatus::Status::Code code);
+        void _fail(const BurpStatus::Status::Code code);
+
+    };
+
+}
\ No newline at end of file
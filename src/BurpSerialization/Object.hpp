@@ -1,12 +1,24 @@
 #pragma once
 
 #include <array>
+#include <type_traits>
 #include "Field.hpp"
+#include "Codes.hpp"
+#include "KeyIndex.hpp"
+#include "MemoryAccounting.hpp"
 
 namespace BurpSerialization
 {
 
-    template <size_t entryCount>
+    // Name is const char * or, to keep the names out of RAM on the
+    // ESP8266, const FlashString *:
+    //
+    //     const char ssidName[] PROGMEM = "ssid";
+    //     using Network = Object<2, CopiedCodes, const FlashString *>;
+    //     Network network({
+    //         Network::Entry({flashString(ssidName), &ssid}),
+    //         ...
+    template <size_t entryCount, template <class> class Codes = CopiedCodes, class Name = const char *>
     class Object : public Field
     {
 
@@ -19,32 +31,79 @@ namespace BurpSerialization
         };
 
         struct Entry {
-            const char * name;
+            Name name;
             const Field * field;
         };
         using Entries = std::array<Entry, entryCount>;
 
-        Object(const Entries entries, const StatusCodes statusCodes, bool & isNull) :
+        // keysLength is the total length of the entry names, followed by
+        // the capacity of each entry in order. Names in flash are copied by
+        // serialize too.
+        template <class... Capacities>
+        static constexpr Capacity capacity(const size_t keysLength, const Capacities... entries) {
+            static_assert(sizeof...(Capacities) == entryCount, "one capacity per entry");
+            return Capacity{
+                JSON_OBJECT_SIZE(entryCount),
+                keysLength + entryCount * JSON_STRING_SIZE(0),
+                std::is_same<Name, const char *>::value ? 0 : keysLength + entryCount * JSON_STRING_SIZE(0)
+            } + sumCapacity(entries...);
+        }
+
+        Object(const Entries entries, typename Codes<StatusCodes>::Argument statusCodes, bool & isNull) :
             _entries(entries),
+            _index(entries, &Entry::name),
             _statusCodes(statusCodes),
             _isNull(isNull)
-        {}
+        {
+            for (size_t index = 0; index < entryCount; index++) {
+                _keys[index] = _makeKey(entries[index].name);
+            }
+        }
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override {
+            return _deserializeWith(serialized, CallField{_entries});
+        }
+
+        // the object stays null after a failure
+        BurpStatus::Status::Code deserializeFailFast(const JsonVariant & serialized) const override {
+            return _deserializeFailFastWith(serialized, CallField{_entries});
+        }
+
+        BurpStatus::Status::Code deserializePatch(const JsonVariant & patch) const override {
+            return _deserializePatchWith(patch, CallField{_entries});
+        }
+
+        bool beginObject() const override {
             _isNull = true;
-            if (serialized.isNull()) {
-                return _statusCodes.notPresent;
-            }
-            if (serialized.is<JsonObject>()) {
-                auto ret = _statusCodes.ok;
-                for (auto entry : _entries) {
-                    auto code = entry.field->deserialize(serialized[entry.name]);
-                    if (code != _statusCodes.ok) ret = code;
-                }
-                _isNull = false;
-                return ret;
+            _present = {};
+            _code = _statusCodes.get(&StatusCodes::ok);
+            _cursor = 0;
+            return true;
+        }
+
+        const Field * member(const char * key) const override {
+            auto index = _find(key, _cursor);
+            if (index == KeyIndex<entryCount>::notFound) return nullptr;
+            _present[index / 8] |= 1 << (index % 8);
+            _cursor = static_cast<Cursor>(index + 1);
+            return _entries[index].field;
+        }
+
+        // the last failure as the members arrive, then as for deserialize
+        // the members that never arrived in entry order. Only the value of
+        // a repeated key is replaced, a failure of the earlier one stays.
+        void childDeserialized(const BurpStatus::Status::Code code) const override {
+            if (code != _statusCodes.get(&StatusCodes::ok)) _code = code;
+        }
+
+        BurpStatus::Status::Code endContainer() const override {
+            for (size_t index = 0; index < entryCount; index++) {
+                if (_isPresent(_present.data(), index)) continue;
+                auto code = _entries[index].field->deserialize(JsonVariant());
+                if (code != _statusCodes.get(&StatusCodes::ok)) _code = code;
             }
-            return _statusCodes.wrongType;
+            _isNull = false;
+            return _code;
         }
 
         bool serialize(const JsonVariant & serialized) const override {
@@ -53,17 +112,273 @@ namespace BurpSerialization
                 return true;
             }
             for (auto entry : _entries) {
-                if (!entry.field->serialize(serialized[entry.name].template to<JsonVariant>())) return false;
+                auto member = serialized[jsonString(entry.name)].template to<JsonVariant>();
+                MemoryAccounting::Scope scope(entry.name, member, MemoryAccounting::Direction::serialize);
+                if (!entry.field->serialize(member)) return false;
             }
             return true;
         }
 
-    private:
+        bool write(Writer & writer) const override {
+            if (_isNull) {
+                return writer.null();
+            }
+            if (!writer.beginObject(entryCount)) return false;
+            for (size_t index = 0; index < entryCount; index++) {
+                if (!_writeKey(writer, index)) return false;
+                if (!_entries[index].field->write(writer)) return false;
+            }
+            return writer.endObject();
+        }
+
+        bool isNull() const override {
+            return _isNull;
+        }
+
+        bool encode(BinaryEncoder & encoder) const override {
+            std::array<uint8_t, bitmapSize> bitmap = {};
+            for (size_t index = 0; index < entryCount; index++) {
+                if (!_entries[index].field->isNull()) bitmap[index / 8] |= 1 << (index % 8);
+            }
+            if (encoder.write(bitmap.data(), bitmapSize) != bitmapSize) return false;
+            for (size_t index = 0; index < entryCount; index++) {
+                if (_isPresent(bitmap.data(), index) && !_entries[index].field->encode(encoder)) return false;
+            }
+            return true;
+        }
+
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override {
+            auto bitmap = decoder.read(bitmapSize);
+            if (bitmap == nullptr) return deserialize(JsonVariant());
+            // absent entries are left as not present, as in deserialize
+            auto ret = _statusCodes.get(&StatusCodes::ok);
+            for (size_t index = 0; index < entryCount; index++) {
+                auto field = _entries[index].field;
+                auto code = _isPresent(bitmap, index) ? field->decode(decoder) : field->deserialize(JsonVariant());
+                if (code != _statusCodes.get(&StatusCodes::ok)) ret = code;
+            }
+            _isNull = false;
+            return ret;
+        }
+
+        uint32_t fingerprint(uint32_t hash) const override {
+            hash = hashKey("{", hash);
+            for (auto & entry : _entries) {
+                hash = entry.field->fingerprint(hashKey(entry.name, hash));
+            }
+            return hashKey("}", hash);
+        }
+
+        // a slot for whether the object is null, then the entries' slots
+        size_t deltaSlots() const override {
+            size_t slots = 1;
+            for (auto & entry : _entries) {
+                slots += entry.field->deltaSlots();
+            }
+            return slots;
+        }
+
+        bool markChanged(Delta & delta) const override {
+            auto encoder = delta.encoder();
+            encoder.write(_isNull ? 0 : 1);
+            auto own = delta.mark(encoder);
+            bool changed = delta.dirty(own);
+            for (auto & entry : _entries) {
+                // every entry is marked so the slots stay in step
+                if (entry.field->markChanged(delta)) changed = true;
+            }
+            if (changed) delta.setDirty(own);
+            return changed;
+        }
+
+        bool serializeDelta(const JsonVariant & serialized, Delta & delta) const override {
+            auto own = delta.position();
+            if (delta.replaced(own)) {
+                // null to object or back, a merge would leave stale entries
+                delta.skip(deltaSlots());
+                return serialize(serialized);
+            }
+            delta.skip(1);
+            serialized.template to<JsonObject>();
+            for (auto & entry : _entries) {
+                if (!delta.dirty(delta.position())) {
+                    delta.skip(entry.field->deltaSlots());
+                    continue;
+                }
+                auto member = serialized[jsonString(entry.name)].template to<JsonVariant>();
+                MemoryAccounting::Scope scope(entry.name, member, MemoryAccounting::Direction::serialize);
+                if (!entry.field->serializeDelta(member, delta)) return false;
+            }
+            return true;
+        }
+
+    protected:
+
+        // how to emit each `"name":` fragment, worked out once: the name
+        // length in the low 15 bits (all ones for a longer name, which is
+        // then measured again on write) and whether it needs escaping in
+        // the top bit
+        using Key = uint16_t;
+        static constexpr Key escapeBit = 0x8000;
+        static constexpr Key lengthMask = 0x7fff;
 
         const Entries _entries;
-        const StatusCodes _statusCodes;
+        const KeyIndex<entryCount, Name> _index;
+        std::array<Key, entryCount> _keys;
+        const Codes<StatusCodes> _statusCodes;
         bool & _isNull;
 
+        bool _writeKey(Writer & writer, const size_t index) const {
+            auto name = _entries[index].name;
+            size_t length = _keys[index] & lengthMask;
+            if (length == lengthMask) {
+                while (stringAt(name, length)) length++;
+            }
+            return writer.key(name, length, _keys[index] & escapeBit);
+        }
+
+        size_t _find(const char * key, size_t cursor) const {
+            // keys usually arrive in schema order
+            if (cursor < entryCount && stringEquals(_entries[cursor].name, key)) return cursor;
+            return _index.find(_entries, &Entry::name, key);
+        }
+
+        // The walks over a JSON object, shared with StaticObject. They
+        // call each entry through callEntry(index, value, call), which
+        // here goes through Field and there through the entry's own type.
+        enum class Call {
+            deserialize,
+            deserializeFailFast,
+            deserializePatch
+        };
+
+        template <class CallEntry>
+        BurpStatus::Status::Code _deserializeWith(const JsonVariant & serialized, const CallEntry & callEntry) const {
+            _isNull = true;
+            if (serialized.isNull()) {
+                return _statusCodes.get(&StatusCodes::notPresent);
+            }
+            if (serialized.is<JsonObject>()) {
+                // walk the members once, then settle the codes in entry order
+                std::array<BurpStatus::Status::Code, entryCount> codes;
+                std::array<bool, entryCount> present = {};
+                size_t cursor = 0;
+                for (JsonPair member : serialized.as<JsonObject>()) {
+                    auto index = _find(member.key().c_str(), cursor);
+                    // unknown keys are ignored and, as in ArduinoJson and
+                    // member(), a repeated key replaces the earlier value
+                    if (index == KeyIndex<entryCount>::notFound) continue;
+                    present[index] = true;
+                    MemoryAccounting::Scope scope(_entries[index].name, member.value(), MemoryAccounting::Direction::deserialize);
+                    codes[index] = callEntry(index, member.value(), Call::deserialize);
+                    cursor = index + 1;
+                }
+                auto ret = _statusCodes.get(&StatusCodes::ok);
+                for (size_t index = 0; index < entryCount; index++) {
+                    auto code = present[index] ? codes[index] : callEntry(index, JsonVariant(), Call::deserialize);
+                    if (code != _statusCodes.get(&StatusCodes::ok)) ret = code;
+                }
+                _isNull = false;
+                return ret;
+            }
+            return _statusCodes.get(&StatusCodes::wrongType);
+        }
+
+        template <class CallEntry>
+        BurpStatus::Status::Code _deserializeFailFastWith(const JsonVariant & serialized, const CallEntry & callEntry) const {
+            if (!serialized.is<JsonObject>()) {
+                return deserialize(serialized);
+            }
+            _isNull = true;
+            std::array<bool, entryCount> present = {};
+            size_t cursor = 0;
+            for (JsonPair member : serialized.as<JsonObject>()) {
+                auto index = _find(member.key().c_str(), cursor);
+                if (index == KeyIndex<entryCount>::notFound) continue;
+                present[index] = true;
+                MemoryAccounting::Scope scope(_entries[index].name, member.value(), MemoryAccounting::Direction::deserialize);
+                auto code = callEntry(index, member.value(), Call::deserializeFailFast);
+                if (code != _statusCodes.get(&StatusCodes::ok)) return code;
+                cursor = index + 1;
+            }
+            for (size_t index = 0; index < entryCount; index++) {
+                if (present[index]) continue;
+                auto code = callEntry(index, JsonVariant(), Call::deserialize);
+                if (code != _statusCodes.get(&StatusCodes::ok)) return code;
+            }
+            _isNull = false;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+
+        template <class CallEntry>
+        BurpStatus::Status::Code _deserializePatchWith(const JsonVariant & patch, const CallEntry & callEntry) const {
+            if (!patch.is<JsonObject>()) {
+                return deserialize(patch);
+            }
+            // patching a null object starts from an empty one, so the
+            // members not in the patch are checked as not present
+            bool wasNull = _isNull;
+            std::array<BurpStatus::Status::Code, entryCount> codes;
+            std::array<bool, entryCount> present = {};
+            size_t cursor = 0;
+            for (JsonPair member : patch.as<JsonObject>()) {
+                auto index = _find(member.key().c_str(), cursor);
+                if (index == KeyIndex<entryCount>::notFound) continue;
+                present[index] = true;
+                MemoryAccounting::Scope scope(_entries[index].name, member.value(), MemoryAccounting::Direction::deserialize);
+                codes[index] = callEntry(index, member.value(), Call::deserializePatch);
+                cursor = index + 1;
+            }
+            auto ret = _statusCodes.get(&StatusCodes::ok);
+            for (size_t index = 0; index < entryCount; index++) {
+                if (!present[index]) {
+                    if (!wasNull) continue;
+                    codes[index] = callEntry(index, JsonVariant(), Call::deserialize);
+                }
+                if (codes[index] != _statusCodes.get(&StatusCodes::ok)) ret = codes[index];
+            }
+            _isNull = false;
+            return ret;
+        }
+
+    private:
+
+        static constexpr size_t bitmapSize = (entryCount + 7) / 8;
+
+        struct CallField {
+            const Entries & entries;
+
+            BurpStatus::Status::Code operator()(const size_t index, const JsonVariant & value, const Call call) const {
+                auto field = entries[index].field;
+                switch (call) {
+                    case Call::deserializeFailFast: return field->deserializeFailFast(value);
+                    case Call::deserializePatch: return field->deserializePatch(value);
+                    default: return field->deserialize(value);
+                }
+            }
+        };
+
+        // incremental deserialization state: the members that arrived,
+        // the running code and where the next key is expected
+        using Cursor = IndexType<entryCount + 1>;
+        mutable std::array<uint8_t, bitmapSize> _present;
+        mutable BurpStatus::Status::Code _code;
+        mutable Cursor _cursor;
+
+        static Key _makeKey(const Name name) {
+            size_t length = 0;
+            Key key = 0;
+            for (; stringAt(name, length); length++) {
+                auto c = static_cast<uint8_t>(stringAt(name, length));
+                if (c < 0x20 || c == '"' || c == '\\') key = escapeBit;
+            }
+            return key | static_cast<Key>(length < lengthMask ? length : lengthMask);
+        }
+
+        static bool _isPresent(const uint8_t * bitmap, const size_t index) {
+            return (bitmap[index / 8] >> (index % 8)) & 1;
+        }
+
     };
     
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Field.hpp"
+#include "Codes.hpp"
+
+namespace BurpSerialization
+{
+
+    // A CStr that copies into a buffer in its Value rather than pointing
+    // into the JsonDocument, so the document can be freed as soon as
+    // deserialize returns. Serialize still stores a pointer, to the
+    // buffer. The binary form is the same as CStr's.
+    template <size_t maxLength, template <class> class Codes = CopiedCodes>
+    class OwnedCStr : public Field
+    {
+
+    public:
+
+        struct Value {
+            bool isNull = false;
+            char value[maxLength + 1] = {};
+        };
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code notPresent; // set to ok if not required
+            const BurpStatus::Status::Code wrongType;
+            const BurpStatus::Status::Code tooShort;
+            const BurpStatus::Status::Code tooLong;
+        };
+
+        // the same as CStr, serialize stores a pointer to the buffer
+        static constexpr Capacity capacity() {
+            return {0, JSON_STRING_SIZE(maxLength), 0};
+        }
+
+        OwnedCStr(const size_t minLength, typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
+            _minLength(minLength),
+            _statusCodes(statusCodes),
+            _value(value)
+        {}
+
+        BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override {
+            _clear();
+            if (serialized.isNull()) {
+                return _statusCodes.get(&StatusCodes::notPresent);
+            }
+            if (serialized.is<const char *>()) {
+                return _set(serialized.as<const char *>());
+            }
+            return _statusCodes.get(&StatusCodes::wrongType);
+        }
+
+        bool serialize(const JsonVariant & serialized) const override {
+            if (_value.isNull) {
+                serialized.clear();
+                return true;
+            }
+            return serialized.set(static_cast<const char *>(_value.value));
+        }
+
+        bool write(Writer & writer) const override {
+            if (_value.isNull) {
+                return writer.null();
+            }
+            return writer.string(_value.value);
+        }
+
+        bool isNull() const override {
+            return _value.isNull;
+        }
+
+        bool encode(BinaryEncoder & encoder) const override {
+            auto length = strlen(_value.value);
+            return encoder.lengthPrefix(length) && encoder.write(reinterpret_cast<const uint8_t *>(_value.value), length) == length;
+        }
+
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override {
+            size_t length;
+            const char * value = nullptr;
+            if (decoder.lengthPrefix(length)) value = decoder.string(length);
+            if (value == nullptr) return deserialize(JsonVariant());
+            _clear();
+            return _set(value);
+        }
+
+        uint32_t fingerprint(const uint32_t hash) const override {
+            return hashKey("s", hash);
+        }
+
+    private:
+
+        const size_t _minLength;
+        const Codes<StatusCodes> _statusCodes;
+        Value & _value;
+
+        void _clear() const {
+            _value.isNull = true;
+            _value.value[0] = '\0';
+        }
+
+        // checks the length while copying, never reading past maxLength + 1
+        BurpStatus::Status::Code _set(const char * value) const {
+            size_t length = 0;
+            for (; value[length]; length++) {
+                if (length == maxLength) {
+                    _value.value[0] = '\0';
+                    return _statusCodes.get(&StatusCodes::tooLong);
+                }
+                _value.value[length] = value[length];
+            }
+            _value.value[length] = '\0';
+            if (length < _minLength) {
+                _value.value[0] = '\0';
+                return _statusCodes.get(&StatusCodes::tooShort);
+            }
+            _value.isNull = false;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+
+    };
+
+    template <size_t maxLength, template <class> class Codes>
+    struct LinksText<OwnedCStr<maxLength, Codes>> : std::true_type {};
+
+}
\ No newline at end of file
@@ -3,66 +3,42 @@
 namespace BurpSerialization
 {
 
-    PWMLevels::PWMLevels(const StatusCodes statusCodes, Value & value) :
-        _uint8Field({
-            statusCodes.ok,
-            statusCodes.levelNotPresent,
-            statusCodes.levelWrongType
-        }, _temp),
-        _statusCodes(statusCodes),
-        _value(value)
-    {}
+    namespace
+    {
 
-    BurpStatus::Status::Code PWMLevels::deserialize(const JsonVariant & serialized) const {
-        _value.isNull = true;
-        if (serialized.isNull()) {
-            return _statusCodes.notPresent;
+        constexpr uint64_t highBits = 0x8080808080808080ull;
+
+        uint64_t load(const uint8_t * data) {
+            uint64_t word;
+            memcpy(&word, data, sizeof(word));
+            return word;
         }
-        if (serialized.is<JsonArray>()) {
-            auto jsonArray = serialized.as<JsonArray>();
-            auto size = jsonArray.size();
-            uint8_t lastLevel = 0;
-            if (size > maxLevels) {
-                return _statusCodes.tooLong;
-            }
-            if (size == 0) {
-                return _statusCodes.tooShort;
-            }
-            for (size_t index = 0; index < maxLevels + 1; index++) {
-                if (index < size) {
-                    auto code = _uint8Field.deserialize(jsonArray[index]);
-                    if (code != _statusCodes.ok) return code;
-                    auto level = _temp.isNull ? 0 : _temp.value;
-                    if (level == 0) return _statusCodes.levelZero;
-                    if (level <= lastLevel) return _statusCodes.levelNotIncreasing;
-                    lastLevel = level;
-                    _value.list[index] = level;
-                } else {
-                    // initialize to zeros to ensure zero termination
-                    _value.list[index] = 0;
-                }
-            }
-            _value.isNull = false;
-            _value.length = size;
-            return _statusCodes.ok;
+
+        // the high bit of each byte of current that is above the same
+        // byte of previous, without carries between the bytes
+        uint64_t above(const uint64_t previous, const uint64_t current) {
+            // previous - current byte by byte, then its borrows
+            auto difference = ((previous | highBits) - (current & ~highBits)) ^ ((previous ^ ~current) & highBits);
+            return ((~previous & current) | (~(previous ^ current) & difference)) & highBits;
         }
-        return _statusCodes.wrongType;
+
     }
 
-    bool PWMLevels::serialize(const JsonVariant & serialized) const {
-        if (_value.isNull) {
-            serialized.clear();
-            return true;
+    size_t firstNotIncreasing(const uint8_t * levels, const size_t count) {
+        if (count == 0 || levels[0] == 0) return 0;
+        size_t index = 1;
+        // eight levels at a time against the eight before them, a zero
+        // level is never above the one before it so it shows here too
+        for (; index + sizeof(uint64_t) <= count; index += sizeof(uint64_t)) {
+            if (above(load(levels + index - 1), load(levels + index)) != highBits) break;
         }
-        auto jsonArray = serialized.to<JsonArray>();
-        for (size_t index = 0; index < maxLevels + 1; index++) {
-            auto level = _value.list[index];
-            if (level == 0) return true;
-            auto success = jsonArray.add(level);
-            if (!success) return false;
+        for (; index < count; index++) {
+            if (levels[index] <= levels[index - 1]) return index;
         }
-        // not zero terminated
-        return false;
+        return count;
     }
 
+    template class BasicPWMLevels<CopiedCodes>;
+    template class BasicPWMLevels<SharedCodes>;
+
 }
\ No newline at end of file
@@ -1,19 +1,28 @@
 #pragma once
 
 #include <array>
-#include "Scalar.hpp"
+#include <string.h>
 #include "Field.hpp"
+#include "Codes.hpp"
 
 namespace BurpSerialization
 {
 
-    class PWMLevels : public Field
+    // Strictly increasing levels from 1 to 255, up to levelCount of them.
+    // Only the first length entries of the list are used, so a fixture
+    // with a handful of levels can size the Value to match:
+    //
+    //     using FixtureLevels = BasicPWMLevels<CopiedCodes, 16>;
+    template <template <class> class Codes = CopiedCodes, size_t levelCount = 255>
+    class BasicPWMLevels : public Field
     {
 
     public:
 
-        static constexpr size_t maxLevels = 255;
-        using List = std::array<uint8_t, maxLevels + 1>;
+        static_assert(levelCount > 0 && levelCount <= 255, "levels are 1 to 255 and strictly increasing");
+
+        static constexpr size_t maxLevels = levelCount;
+        using List = std::array<uint8_t, maxLevels>;
 
         struct Value {
             bool isNull = false;
@@ -33,18 +42,269 @@ namespace BurpSerialization
             const BurpStatus::Status::Code levelWrongType;
         };
 
-        PWMLevels(const StatusCodes statusCodes, Value & value);
+        static constexpr Capacity capacity() {
+            return {JSON_ARRAY_SIZE(maxLevels), 0, 0};
+        }
+
+        BasicPWMLevels(typename Codes<StatusCodes>::Argument statusCodes, Value & value);
 
         BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
+        BurpStatus::Status::Code deserializeFailFast(const JsonVariant & serialized) const override;
         bool serialize(const JsonVariant & serialized) const override;
+        bool write(Writer & writer) const override;
+        BurpStatus::Status::Code deserializeBinary(const uint8_t * data, const size_t length) const override;
+        bool isNull() const override;
+        bool encode(BinaryEncoder & encoder) const override;
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override;
+        uint32_t fingerprint(const uint32_t hash) const override;
+
+        bool beginArray() const override;
+        const Field * element() const override;
+        void childDeserialized(const BurpStatus::Status::Code code) const override;
+        BurpStatus::Status::Code endContainer() const override;
 
     private:
 
-        Scalar<uint8_t> _uint8Field;
-        Scalar<uint8_t>::Value _temp;
-        const StatusCodes _statusCodes;
+        // each element, checked against the level codes of the parent
+        // rather than a Scalar holding its own copy of them
+        class Level : public Field
+        {
+
+        public:
+
+            Level(const BasicPWMLevels & levels) :
+                _levels(levels)
+            {}
+
+            BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override;
+
+            bool serialize(const JsonVariant &) const override {
+                return false;
+            }
+
+        private:
+
+            const BasicPWMLevels & _levels;
+
+        };
+
+        const Level _levelField;
+        const Codes<StatusCodes> _statusCodes;
         Value & _value;
 
+        // element by element deserialization state
+        mutable size_t _count;
+        // the index of the first element that failed, with its code
+        mutable size_t _failed;
+        mutable BurpStatus::Status::Code _code;
+        mutable uint8_t _level;
+
+        BurpStatus::Status::Code _validate() const;
+
     };
-    
+
+    // the index of the first level that is zero or not above the one
+    // before it, or count if there is none
+    size_t firstNotIncreasing(const uint8_t * levels, const size_t count);
+
+    template <template <class> class Codes, size_t levelCount>
+    BasicPWMLevels<Codes, levelCount>::BasicPWMLevels(typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
+        _levelField(*this),
+        _statusCodes(statusCodes),
+        _value(value)
+    {}
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::deserialize(const JsonVariant & serialized) const {
+        _value.isNull = true;
+        if (serialized.isNull()) {
+            return _statusCodes.get(&StatusCodes::notPresent);
+        }
+        if (serialized.is<JsonArray>()) {
+            auto jsonArray = serialized.as<JsonArray>();
+            if (jsonArray.size() > maxLevels) {
+                return _statusCodes.get(&StatusCodes::tooLong);
+            }
+            beginArray();
+            for (auto level : jsonArray) {
+                childDeserialized(_levelField.deserialize(level));
+            }
+            return endContainer();
+        }
+        return _statusCodes.get(&StatusCodes::wrongType);
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::deserializeFailFast(const JsonVariant & serialized) const {
+        if (!serialized.is<JsonArray>()) {
+            return deserialize(serialized);
+        }
+        _value.isNull = true;
+        auto jsonArray = serialized.as<JsonArray>();
+        if (jsonArray.size() > maxLevels) {
+            return _statusCodes.get(&StatusCodes::tooLong);
+        }
+        // the length is already checked, so the levels before the first
+        // bad one are all that is left to decide the code
+        beginArray();
+        for (auto level : jsonArray) {
+            childDeserialized(_levelField.deserialize(level));
+            if (_code != _statusCodes.get(&StatusCodes::ok)) break;
+        }
+        return endContainer();
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::Level::deserialize(const JsonVariant & serialized) const {
+        _levels._level = 0;
+        if (serialized.isNull()) {
+            return _levels._statusCodes.get(&StatusCodes::levelNotPresent);
+        }
+        if (serialized.is<uint8_t>()) {
+            _levels._level = serialized.as<uint8_t>();
+            return _levels._statusCodes.get(&StatusCodes::ok);
+        }
+        return _levels._statusCodes.get(&StatusCodes::levelWrongType);
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    bool BasicPWMLevels<Codes, levelCount>::beginArray() const {
+        _value.isNull = true;
+        _count = 0;
+        _code = _statusCodes.get(&StatusCodes::ok);
+        return true;
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    const Field * BasicPWMLevels<Codes, levelCount>::element() const {
+        return &_levelField;
+    }
+
+    // the levels are only stored here, the order is checked in one pass
+    // by endContainer
+    template <template <class> class Codes, size_t levelCount>
+    void BasicPWMLevels<Codes, levelCount>::childDeserialized(const BurpStatus::Status::Code code) const {
+        auto index = _count++;
+        // keep counting past the first error so that tooLong still wins
+        if (index >= maxLevels || _code != _statusCodes.get(&StatusCodes::ok)) return;
+        if (code != _statusCodes.get(&StatusCodes::ok)) {
+            _code = code;
+            _failed = index;
+            return;
+        }
+        _value.list[index] = _level;
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::endContainer() const {
+        if (_count > maxLevels) {
+            return _statusCodes.get(&StatusCodes::tooLong);
+        }
+        if (_count == 0) {
+            return _statusCodes.get(&StatusCodes::tooShort);
+        }
+        return _validate();
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::_validate() const {
+        auto ok = _statusCodes.get(&StatusCodes::ok);
+        // the levels before a failed element are stored, and an order
+        // error among them comes first
+        auto checked = _code != ok ? _failed : _count;
+        auto index = firstNotIncreasing(_value.list.data(), checked);
+        if (index < checked) {
+            return _value.list[index] == 0 ? _statusCodes.get(&StatusCodes::levelZero) : _statusCodes.get(&StatusCodes::levelNotIncreasing);
+        }
+        if (_code != ok) {
+            return _code;
+        }
+        _value.isNull = false;
+        _value.length = _count;
+        return ok;
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    bool BasicPWMLevels<Codes, levelCount>::serialize(const JsonVariant & serialized) const {
+        if (_value.isNull) {
+            serialized.clear();
+            return true;
+        }
+        if (_value.length > maxLevels) return false;
+        auto jsonArray = serialized.to<JsonArray>();
+        for (size_t index = 0; index < _value.length; index++) {
+            if (!jsonArray.add(_value.list[index])) return false;
+        }
+        return true;
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    bool BasicPWMLevels<Codes, levelCount>::write(Writer & writer) const {
+        if (_value.isNull) {
+            return writer.null();
+        }
+        auto count = _value.length;
+        if (count > maxLevels) return false;
+        // the levels are bytes, so bin is the compact MessagePack form
+        if (writer.format() == Writer::Format::msgPack) {
+            return writer.binary(_value.list.data(), count);
+        }
+        if (!writer.beginArray(count)) return false;
+        for (size_t index = 0; index < count; index++) {
+            if (!writer.unsignedInteger(_value.list[index])) return false;
+        }
+        return writer.endArray();
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::deserializeBinary(const uint8_t * data, const size_t length) const {
+        _value.isNull = true;
+        if (length > maxLevels) {
+            return _statusCodes.get(&StatusCodes::tooLong);
+        }
+        if (length == 0) {
+            return _statusCodes.get(&StatusCodes::tooShort);
+        }
+        memcpy(_value.list.data(), data, length);
+        _count = length;
+        _code = _statusCodes.get(&StatusCodes::ok);
+        return _validate();
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    bool BasicPWMLevels<Codes, levelCount>::isNull() const {
+        return _value.isNull;
+    }
+
+    // a length then one byte per level
+    template <template <class> class Codes, size_t levelCount>
+    bool BasicPWMLevels<Codes, levelCount>::encode(BinaryEncoder & encoder) const {
+        auto count = _value.length;
+        if (count > maxLevels) return false;
+        return encoder.lengthPrefix(count) && encoder.write(_value.list.data(), count) == count;
+    }
+
+    template <template <class> class Codes, size_t levelCount>
+    BurpStatus::Status::Code BasicPWMLevels<Codes, levelCount>::decode(BinaryDecoder & decoder) const {
+        size_t length;
+        const uint8_t * data = nullptr;
+        if (decoder.lengthPrefix(length)) data = decoder.read(length);
+        if (data == nullptr) return deserialize(JsonVariant());
+        return deserializeBinary(data, length);
+    }
+
+    // the binary form does not depend on the capacity, a longer list is
+    // rejected as tooLong
+    template <template <class> class Codes, size_t levelCount>
+    uint32_t BasicPWMLevels<Codes, levelCount>::fingerprint(const uint32_t hash) const {
+        return hashKey("pwm", hash);
+    }
+
+    using PWMLevels = BasicPWMLevels<>;
+    // one pointer to a shared status table, see SharedCodes
+    using SharedPWMLevels = BasicPWMLevels<SharedCodes>;
+
+    extern template class BasicPWMLevels<CopiedCodes>;
+    extern template class BasicPWMLevels<SharedCodes>;
+
 }
\ No newline at end of file
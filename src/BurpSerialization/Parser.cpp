@@ -0,0 +1,335 @@
+#include <string.h>
+#include "Parser.hpp"
+
+namespace BurpSerialization
+{
+
+    bool isJsonWhitespace(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // numbers, true, false and null
+    bool isJsonPrimitive(const char c) {
+        return (c >= '0' && c <= '9') ||
+            (c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') ||
+            c == '-' || c == '+' || c == '.';
+    }
+
+    Parser::Parser(const Field & root, char * buffer, const size_t size, const StatusCodes statusCodes) :
+        _root(root),
+        _buffer(buffer),
+        _size(size),
+        _statusCodes(statusCodes)
+    {
+        begin();
+    }
+
+    void Parser::begin() {
+        _depth = 0;
+        _state = State::value;
+        _error = _statusCodes.ok;
+        _result = _statusCodes.ok;
+        _target = nullptr;
+        _used = 0;
+        _tokenLength = 0;
+        _isKey = false;
+        _escaped = false;
+        _hexDigits = 0;
+        _copying = false;
+        _primitive = Primitive::start;
+        _literal = nullptr;
+    }
+
+    BurpStatus::Status::Code Parser::write(const char * data, const size_t length) {
+        for (size_t index = 0; index < length && _state != State::failed; index++) {
+            _feed(data[index]);
+        }
+        return _error;
+    }
+
+    BurpStatus::Status::Code Parser::end() {
+        // a number at the root has nothing after it to end it
+        if (_state == State::primitive && _depth == 0) {
+            _endPrimitive();
+        }
+        if (_state == State::failed) {
+            return _error;
+        }
+        if (_state != State::done) {
+            return _statusCodes.incomplete;
+        }
+        return _result;
+    }
+
+    void Parser::_feed(const char c) {
+        switch (_state) {
+            case State::value:
+            case State::firstValue:
+                if (isJsonWhitespace(c)) return;
+                if (c == ']' && _state == State::firstValue) return _close();
+                return _startValue(c);
+            case State::key:
+            case State::firstKey:
+                if (isJsonWhitespace(c)) return;
+                if (c == '}' && _state == State::firstKey) return _close();
+                if (c != '"') return _fail(_statusCodes.invalidInput);
+                _startToken(c, _frames[_depth - 1].field != nullptr);
+                _isKey = true;
+                _state = State::string;
+                return;
+            case State::colon:
+                if (isJsonWhitespace(c)) return;
+                if (c != ':') return _fail(_statusCodes.invalidInput);
+                _state = State::value;
+                return;
+            case State::next: {
+                if (isJsonWhitespace(c)) return;
+                auto isArray = _frames[_depth - 1].isArray;
+                if (c == ',') {
+                    _state = isArray ? State::value : State::key;
+                    return;
+                }
+                if (c == (isArray ? ']' : '}')) return _close();
+                return _fail(_statusCodes.invalidInput);
+            }
+            case State::string:
+                if (!_append(c)) return;
+                if (!_copying && !_checkString(c)) return _fail(_statusCodes.invalidInput);
+                if (_escaped) {
+                    _escaped = false;
+                } else if (c == '\\') {
+                    _escaped = true;
+                } else if (c == '"') {
+                    _endString();
+                }
+                return;
+            case State::primitive:
+                if (isJsonPrimitive(c)) {
+                    _append(c);
+                    if (!_copying) _checkPrimitive(c);
+                    return;
+                }
+                _endPrimitive();
+                if (_state != State::failed) _feed(c);
+                return;
+            case State::done:
+                if (isJsonWhitespace(c)) return;
+                return _fail(_statusCodes.invalidInput);
+            case State::failed:
+                return;
+        }
+    }
+
+    void Parser::_startValue(const char c) {
+        if (_depth == 0) {
+            _target = &_root;
+        } else if (_frames[_depth - 1].isArray) {
+            auto parent = _frames[_depth - 1].field;
+            _target = parent == nullptr ? nullptr : parent->element();
+        }
+        // object members have their target set by the key
+        if (c == '{' || c == '[') return _open(c == '[');
+        if (c == '"') {
+            _startToken(c, _target != nullptr);
+            _isKey = false;
+            _state = State::string;
+            return;
+        }
+        if (isJsonPrimitive(c)) {
+            _startToken(c, _target != nullptr);
+            _primitive = Primitive::start;
+            if (!_copying) _checkPrimitive(c);
+            _state = State::primitive;
+            return;
+        }
+        _fail(_statusCodes.invalidInput);
+    }
+
+    void Parser::_startToken(const char c, const bool copying) {
+        _copying = copying;
+        _escaped = false;
+        _hexDigits = 0;
+        _tokenLength = 0;
+        _append(c);
+    }
+
+    bool Parser::_append(const char c) {
+        if (!_copying) return true;
+        if (_used + _tokenLength >= _size) {
+            _fail(_statusCodes.noMemory);
+            return false;
+        }
+        _buffer[_used + _tokenLength] = c;
+        _tokenLength++;
+        return true;
+    }
+
+    bool Parser::_parseToken() {
+        // a char * input is parsed in place, so strings stay in the buffer
+        auto error = deserializeJson(_token, _buffer + _used, _tokenLength);
+        if (error) {
+            _fail(error == DeserializationError::NoMemory ? _statusCodes.noMemory : _statusCodes.invalidInput);
+            return false;
+        }
+        return true;
+    }
+
+    void Parser::_endString() {
+        if (_isKey) {
+            auto parent = _frames[_depth - 1].field;
+            _target = nullptr;
+            if (parent != nullptr) {
+                if (!_parseToken()) return;
+                _target = parent->member(_token.as<const char *>());
+            }
+            // keys are only needed until the member is found
+            _tokenLength = 0;
+            _state = State::colon;
+            return;
+        }
+        if (_copying) {
+            if (!_parseToken()) return;
+            _report(_target->deserialize(_token.as<JsonVariant>()));
+            _used += _tokenLength;
+        }
+        _tokenLength = 0;
+        _endValue();
+    }
+
+    void Parser::_endPrimitive() {
+        if (_copying) {
+            if (!_parseToken()) return;
+            _report(_target->deserialize(_token.as<JsonVariant>()));
+        } else if (!_isPrimitiveComplete()) {
+            return _fail(_statusCodes.invalidInput);
+        }
+        _tokenLength = 0;
+        _endValue();
+    }
+
+    // a skipped string is not parsed, so its escapes and characters are
+    // checked as they go by
+    bool Parser::_checkString(const char c) {
+        if (_hexDigits > 0) {
+            _hexDigits--;
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+        if (_escaped) {
+            if (c == 'u') _hexDigits = 4;
+            return c != 0 && strchr("\"\\/bfnrtu", c) != nullptr;
+        }
+        return static_cast<uint8_t>(c) >= 0x20;
+    }
+
+    void Parser::_checkPrimitive(const char c) {
+        auto isDigit = c >= '0' && c <= '9';
+        auto isExponent = c == 'e' || c == 'E';
+        switch (_primitive) {
+            case Primitive::start:
+                _literal = c == 't' ? "rue" : c == 'f' ? "alse" : c == 'n' ? "ull" : nullptr;
+                _primitive = _literal != nullptr ? Primitive::literal :
+                    c == '-' ? Primitive::minus :
+                    c == '0' ? Primitive::zero :
+                    isDigit ? Primitive::integer : Primitive::invalid;
+                return;
+            case Primitive::literal:
+                if (*_literal == c) {
+                    _literal++;
+                } else {
+                    _primitive = Primitive::invalid;
+                }
+                return;
+            case Primitive::minus:
+                _primitive = c == '0' ? Primitive::zero : isDigit ? Primitive::integer : Primitive::invalid;
+                return;
+            case Primitive::zero:
+            case Primitive::integer:
+                if (isDigit && _primitive == Primitive::integer) return;
+                _primitive = c == '.' ? Primitive::point : isExponent ? Primitive::exponent : Primitive::invalid;
+                return;
+            case Primitive::point:
+            case Primitive::fraction:
+                if (isDigit) {
+                    _primitive = Primitive::fraction;
+                    return;
+                }
+                _primitive = isExponent && _primitive == Primitive::fraction ? Primitive::exponent : Primitive::invalid;
+                return;
+            case Primitive::exponent:
+                _primitive = c == '-' || c == '+' ? Primitive::exponentSign : isDigit ? Primitive::exponentDigits : Primitive::invalid;
+                return;
+            case Primitive::exponentSign:
+            case Primitive::exponentDigits:
+                _primitive = isDigit ? Primitive::exponentDigits : Primitive::invalid;
+                return;
+            case Primitive::invalid:
+                return;
+        }
+    }
+
+    bool Parser::_isPrimitiveComplete() const {
+        switch (_primitive) {
+            case Primitive::literal:
+                return *_literal == 0;
+            case Primitive::zero:
+            case Primitive::integer:
+            case Primitive::fraction:
+            case Primitive::exponentDigits:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void Parser::_open(const bool isArray) {
+        if (_depth == maxDepth) return _fail(_statusCodes.tooDeep);
+        auto field = _target;
+        if (field != nullptr) {
+            auto accepted = isArray ? field->beginArray() : field->beginObject();
+            if (!accepted) {
+                // leaves reject containers with their usual wrong type code
+                if (isArray) {
+                    _token.to<JsonArray>();
+                } else {
+                    _token.to<JsonObject>();
+                }
+                _report(field->deserialize(_token.as<JsonVariant>()));
+                field = nullptr;
+            }
+        }
+        _frames[_depth] = {field, isArray};
+        _depth++;
+        _state = isArray ? State::firstValue : State::firstKey;
+    }
+
+    void Parser::_close() {
+        _depth--;
+        auto field = _frames[_depth].field;
+        if (field != nullptr) {
+            _report(field->endContainer());
+        }
+        _endValue();
+    }
+
+    void Parser::_endValue() {
+        _state = _depth == 0 ? State::done : State::next;
+    }
+
+    void Parser::_report(const BurpStatus::Status::Code code) {
+        if (_depth == 0) {
+            _result = code;
+            return;
+        }
+        auto parent = _frames[_depth - 1].field;
+        if (parent != nullptr) {
+            parent->childDeserialized(code);
+        }
+    }
+
+    void Parser::_fail(const BurpStatus::Status::Code code) {
+        _error = code;
+        _state = State::failed;
+    }
+
+}
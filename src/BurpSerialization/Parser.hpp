@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include "Field.hpp"
+
+namespace BurpSerialization
+{
+
+    // Push parser that feeds JSON text, in chunks of any size, straight
+    // into a Field tree without building a document first. Strings are
+    // kept in the supplied buffer, as fields may hold pointers to them,
+    // so it must outlive the deserialized values. Members that are not
+    // in the schema are skipped without being stored, though still
+    // checked to be valid JSON.
+    class Parser
+    {
+
+    public:
+
+        struct StatusCodes {
+            const BurpStatus::Status::Code ok;
+            const BurpStatus::Status::Code incomplete;
+            const BurpStatus::Status::Code invalidInput;
+            const BurpStatus::Status::Code tooDeep;
+            const BurpStatus::Status::Code noMemory;
+        };
+
+        static constexpr size_t maxDepth = 16;
+
+        Parser(const Field & root, char * buffer, const size_t size, const StatusCodes statusCodes);
+
+        // start a new document, invalidates strings from the last one
+        void begin();
+        // returns ok or the parser error, errors are sticky until begin
+        BurpStatus::Status::Code write(const char * data, const size_t length);
+        // returns the parser error, incomplete or the code from the root field
+        BurpStatus::Status::Code end();
+
+    private:
+
+        enum class State : uint8_t {
+            value,
+            firstValue, // a value or the end of an empty array
+            key,
+            firstKey,   // a key or the end of an empty object
+            colon,
+            next,       // a comma or the end of the container
+            string,
+            primitive,
+            done,
+            failed
+        };
+
+        // how far a skipped number, true, false or null has got through
+        // its grammar, checked a character at a time as it is not stored
+        enum class Primitive : uint8_t {
+            start,
+            literal,    // the rest of it is in _literal
+            minus,
+            zero,
+            integer,
+            point,
+            fraction,
+            exponent,
+            exponentSign,
+            exponentDigits,
+            invalid
+        };
+
+        struct Frame {
+            const Field * field; // nullptr when skipping the container
+            bool isArray;
+        };
+
+        const Field & _root;
+        char * const _buffer;
+        const size_t _size;
+        const StatusCodes _statusCodes;
+        StaticJsonDocument<16> _token;
+        std::array<Frame, maxDepth> _frames;
+        size_t _depth;
+        State _state;
+        BurpStatus::Status::Code _error;
+        BurpStatus::Status::Code _result;
+        const Field * _target;
+        size_t _used;
+        size_t _tokenLength;
+        bool _isKey;
+        bool _escaped;
+        // hex digits still to come in a \u escape of a skipped string
+        uint8_t _hexDigits;
+        bool _copying;
+        Primitive _primitive;
+        const char * _literal;
+
+        void _feed(const char c);
+        void _startValue(const char c);
+        void _startToken(const char c, const bool copying);
+        bool _append(const char c);
+        bool _parseToken();
+        void _endString();
+        void _endPrimitive();
+        bool _checkString(const char c);
+        void _checkPrimitive(const char c);
+        bool _isPrimitiveComplete() const;
+        void _open(const bool isArray);
+        void _close();
+        void _endValue();
+        void _report(const BurpStatus::Status::Code code);
+        void _fail(const BurpStatus::Status::Code code);
+
+    };
+
+}
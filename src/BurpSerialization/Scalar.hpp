@@ -1,12 +1,15 @@
 #pragma once
 
 #include "Field.hpp"
+#include "Codes.hpp"
 #include "functional"
+#include <string.h>
+#include <type_traits>
 
 namespace BurpSerialization
 {
 
-    template <class Type>
+    template <class Type, template <class> class Codes = CopiedCodes>
     class Scalar : public Field
     {
 
@@ -23,7 +26,12 @@ namespace BurpSerialization
             const BurpStatus::Status::Code wrongType;
         };
 
-        Scalar(const StatusCodes statusCodes, Value & value) :
+        // held in the slot of the parent
+        static constexpr Capacity capacity() {
+            return {0, 0, 0};
+        }
+
+        Scalar(typename Codes<StatusCodes>::Argument statusCodes, Value & value) :
             _statusCodes(statusCodes),
             _value(value)
         {}
@@ -31,14 +39,14 @@ namespace BurpSerialization
         BurpStatus::Status::Code deserialize(const JsonVariant & src) const override {
             _value.isNull  = true;
             if (src.isNull()) {
-                return _statusCodes.notPresent;
+                return _statusCodes.get(&StatusCodes::notPresent);
             }
             if (src.is<Type>()) {
                 _value.isNull  = false;
                 _value.value  = src.as<Type>();
-                return _statusCodes.ok;
+                return _statusCodes.get(&StatusCodes::ok);
             }
-            return _statusCodes.wrongType;
+            return _statusCodes.get(&StatusCodes::wrongType);
         }
 
         bool serialize(const JsonVariant & dest) const override {
@@ -49,11 +57,73 @@ namespace BurpSerialization
             return dest.set(_value.value);
         }
 
+        bool write(Writer & writer) const override {
+            if (_value.isNull) {
+                return writer.null();
+            }
+            return _write(writer, std::integral_constant<bool, std::is_integral<Type>::value>());
+        }
+
+        bool isNull() const override {
+            return _value.isNull;
+        }
+
+        bool encode(BinaryEncoder & encoder) const override {
+            return encoder.unsignedInteger(_bits(std::integral_constant<bool, std::is_integral<Type>::value>()), sizeof(Type));
+        }
+
+        BurpStatus::Status::Code decode(BinaryDecoder & decoder) const override {
+            uint64_t bits;
+            if (!decoder.unsignedInteger(bits, sizeof(Type))) return deserialize(JsonVariant());
+            _setBits(bits, std::integral_constant<bool, std::is_integral<Type>::value>());
+            _value.isNull = false;
+            return _statusCodes.get(&StatusCodes::ok);
+        }
+
+        uint32_t fingerprint(uint32_t hash) const override {
+            const uint8_t width = sizeof(Type);
+            hash = hashKey(std::is_integral<Type>::value ? (std::is_signed<Type>::value ? "i" : "u") : "f", hash);
+            return hashBytes(&width, 1, hash);
+        }
+
     private:
 
-        const StatusCodes _statusCodes;
+        const Codes<StatusCodes> _statusCodes;
         Value & _value;
 
+        bool _write(Writer & writer, std::true_type) const {
+            if (std::is_same<Type, bool>::value) return writer.boolean(_value.value);
+            if (std::is_signed<Type>::value) return writer.integer(_value.value);
+            return writer.unsignedInteger(_value.value);
+        }
+
+        // leave float formatting to ArduinoJson
+        bool _write(Writer & writer, std::false_type) const {
+            return Field::write(writer);
+        }
+
+        // the same width unsigned type, for floating point bit patterns
+        using Bits = typename std::conditional<sizeof(Type) == 4, uint32_t, uint64_t>::type;
+
+        uint64_t _bits(std::true_type) const {
+            return static_cast<uint64_t>(_value.value);
+        }
+
+        uint64_t _bits(std::false_type) const {
+            Bits bits;
+            memcpy(&bits, &_value.value, sizeof(Type));
+            return bits;
+        }
+
+        void _setBits(const uint64_t bits, std::true_type) const {
+            _value.value = static_cast<Type>(bits);
+        }
+
+        void _setBits(const uint64_t bits, std::false_type) const {
+            auto sized = static_cast<Bits>(bits);
+            memcpy(&_value.value, &sized, sizeof(Type));
+        }
+
     };
     
 }
\ No newline at end of file
@@ -1,17 +1,54 @@
 #include "Serialization.hpp"
+#include "MemoryAccounting.hpp"
 
 namespace BurpSerialization {
 
-    Serialization::Serialization(const Field & root) :
-        _root(root)
+    Serialization::Serialization(const Field & root, const Mode mode) :
+        _root(root),
+        _mode(mode)
     {}
 
     bool Serialization::serialize(const JsonVariant & dest) const {
+        MemoryAccounting::Scope scope("", dest, MemoryAccounting::Direction::serialize);
         return _root.serialize(dest);
     }
 
+    bool Serialization::serialize(Writer & writer) const {
+        return _root.write(writer);
+    }
+
+    bool Serialization::serialize(BinaryEncoder & encoder) const {
+        return encoder.encode(_root);
+    }
+
+    bool Serialization::serializeDelta(const JsonVariant & dest, Delta & delta) const {
+        if (_root.deltaSlots() > delta.count()) return false;
+        delta.rewind();
+        _root.markChanged(delta);
+        delta.rewind();
+        dest.clear();
+        if (delta.changed()) {
+            MemoryAccounting::Scope scope("", dest, MemoryAccounting::Direction::serialize);
+            // not committed, so the same changes are picked up next time
+            if (!_root.serializeDelta(dest, delta)) return false;
+        }
+        delta.commit();
+        return true;
+    }
+
     BurpStatus::Status::Code Serialization::deserialize(const JsonVariant & src) {
+        MemoryAccounting::Scope scope("", src, MemoryAccounting::Direction::deserialize);
+        if (_mode == Mode::failFast) return _root.deserializeFailFast(src);
         return _root.deserialize(src);
     }
 
+    BurpStatus::Status::Code Serialization::deserializePatch(const JsonVariant & patch) {
+        MemoryAccounting::Scope scope("", patch, MemoryAccounting::Direction::deserialize);
+        return _root.deserializePatch(patch);
+    }
+
+    BurpStatus::Status::Code Serialization::deserialize(BinaryDecoder & decoder, const uint8_t * data, const size_t length) {
+        return decoder.decode(_root, data, length);
+    }
+
 }
\ No newline at end of file
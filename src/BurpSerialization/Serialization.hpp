@@ -8,13 +8,34 @@ namespace BurpSerialization {
 
         public:
 
-            Serialization(const Field & root);
+            // How deserialize reports invalid input. collectAll visits
+            // every field and returns the last failure in schema order.
+            // failFast returns the first failure in document order and
+            // skips the rest, which is cheaper when most input is
+            // rejected.
+            enum class Mode {
+                collectAll,
+                failFast
+            };
+
+            Serialization(const Field & root, const Mode mode = Mode::collectAll);
             bool serialize(const JsonVariant & dest) const;
+            bool serialize(Writer & writer) const;
+            bool serialize(BinaryEncoder & encoder) const;
+            // Only what changed since the last successful call, as a JSON
+            // merge patch (RFC 7386), see Delta. Leaves dest null when
+            // nothing changed, delta.changed() tells the two apart. The
+            // delta needs at least the root's deltaSlots().
+            bool serializeDelta(const JsonVariant & dest, Delta & delta) const;
             BurpStatus::Status::Code deserialize(const JsonVariant & src);
+            // updates only the values in the patch, see Field::deserializePatch
+            BurpStatus::Status::Code deserializePatch(const JsonVariant & patch);
+            BurpStatus::Status::Code deserialize(BinaryDecoder & decoder, const uint8_t * data, const size_t length);
 
         private:
 
             const Field & _root;
+            const Mode _mode;
 
     };
 
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include "Object.hpp"
+
+namespace BurpSerialization
+{
+
+    // An Object whose entry types are known at compile time. The JSON
+    // document and Writer paths call each entry through its own type, so
+    // there is no virtual call below the StaticObject and fields defined
+    // in headers (Scalar, CStrMap, nested StaticObjects) are inlined. The
+    // walks over a JSON object, for every deserialize mode, are Object's
+    // own, so the two behave the same. The status codes are the same as
+    // Object's, and Parser, the binary codec and the fingerprint go
+    // through the Object base as before.
+    //
+    //     using Network = StaticObject<IPv4, CStr>;
+    //     Network network({"ip", "host"}, Network::Members(ip, host), {0, 1, 2}, isNull);
+    template <class... Fields>
+    class StaticObject : public Object<sizeof...(Fields)>
+    {
+
+    public:
+
+        static constexpr size_t entryCount = sizeof...(Fields);
+        using Base = Object<entryCount>;
+        using StatusCodes = typename Base::StatusCodes;
+        using Names = std::array<const char *, entryCount>;
+        using Members = std::tuple<const Fields &...>;
+
+        StaticObject(const Names names, const Members members, const StatusCodes statusCodes, bool & isNull) :
+            Base(_makeEntries(names, members), statusCodes, isNull)
+        {}
+
+        BurpStatus::Status::Code deserialize(const JsonVariant & serialized) const override {
+            return this->_deserializeWith(serialized, CallMember{*this});
+        }
+
+        BurpStatus::Status::Code deserializeFailFast(const JsonVariant & serialized) const override {
+            return this->_deserializeFailFastWith(serialized, CallMember{*this});
+        }
+
+        BurpStatus::Status::Code deserializePatch(const JsonVariant & patch) const override {
+            return this->_deserializePatchWith(patch, CallMember{*this});
+        }
+
+        bool serialize(const JsonVariant & serialized) const override {
+            if (this->_isNull) {
+                serialized.clear();
+                return true;
+            }
+            return _serializeFrom<0>(serialized);
+        }
+
+        bool write(Writer & writer) const override {
+            if (this->_isNull) {
+                return writer.null();
+            }
+            if (!writer.beginObject(entryCount)) return false;
+            if (!_writeFrom<0>(writer)) return false;
+            return writer.endObject();
+        }
+
+    private:
+
+        template <size_t index>
+        using FieldAt = typename std::tuple_element<index, std::tuple<Fields...>>::type;
+
+        // the base keeps the entries as Field pointers, the types are
+        // known here so there is nothing more to store
+        template <size_t index>
+        const FieldAt<index> & _member() const {
+            return *static_cast<const FieldAt<index> *>(this->_entries[index].field);
+        }
+
+        template <size_t index = 0>
+        static typename std::enable_if<(index < entryCount)>::type _fillEntries(typename Base::Entries & entries, const Names & names, const Members & members) {
+            entries[index] = {names[index], &std::get<index>(members)};
+            _fillEntries<index + 1>(entries, names, members);
+        }
+
+        template <size_t index>
+        static typename std::enable_if<(index == entryCount)>::type _fillEntries(typename Base::Entries &, const Names &, const Members &) {}
+
+        static typename Base::Entries _makeEntries(const Names & names, const Members & members) {
+            typename Base::Entries entries;
+            _fillEntries(entries, names, members);
+            return entries;
+        }
+
+        using Call = typename Base::Call;
+
+        // for the Object walks
+        struct CallMember {
+            const StaticObject & object;
+
+            BurpStatus::Status::Code operator()(const size_t index, const JsonVariant & value, const Call call) const {
+                return object._callAt(index, value, call);
+            }
+        };
+
+        // a chain of compares on a constant, which compilers turn into a
+        // jump table
+        template <size_t index = 0>
+        typename std::enable_if<(index < entryCount), BurpStatus::Status::Code>::type _callAt(const size_t target, const JsonVariant & serialized, const Call call) const {
+            using Type = FieldAt<index>;
+            if (target != index) return _callAt<index + 1>(target, serialized, call);
+            auto & member = _member<index>();
+            switch (call) {
+                case Call::deserializeFailFast: return member.Type::deserializeFailFast(serialized);
+                case Call::deserializePatch: return member.Type::deserializePatch(serialized);
+                default: return member.Type::deserialize(serialized);
+            }
+        }
+
+        template <size_t index>
+        typename std::enable_if<(index == entryCount), BurpStatus::Status::Code>::type _callAt(const size_t, const JsonVariant &, const Call) const {
+            return this->_statusCodes.get(&StatusCodes::ok);
+        }
+
+        template <size_t index>
+        typename std::enable_if<(index < entryCount), bool>::type _serializeFrom(const JsonVariant & serialized) const {
+            using Type = FieldAt<index>;
+            auto name = this->_entries[index].name;
+            auto member = serialized[name].template to<JsonVariant>();
+            MemoryAccounting::Scope scope(name, member, MemoryAccounting::Direction::serialize);
+            if (!_member<index>().Type::serialize(member)) return false;
+            return _serializeFrom<index + 1>(serialized);
+        }
+
+        template <size_t index>
+        typename std::enable_if<(index == entryCount), bool>::type _serializeFrom(const JsonVariant &) const {
+            return true;
+        }
+
+        template <size_t index>
+        typename std::enable_if<(index < entryCount), bool>::type _writeFrom(Writer & writer) const {
+            using Type = FieldAt<index>;
+            if (!this->_writeKey(writer, index)) return false;
+            if (!_member<index>().Type::write(writer)) return false;
+            return _writeFrom<index + 1>(writer);
+        }
+
+        template <size_t index>
+        typename std::enable_if<(index == entryCount), bool>::type _writeFrom(Writer &) const {
+            return true;
+        }
+
+    };
+
+}
\ No newline at end of file
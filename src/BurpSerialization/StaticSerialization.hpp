@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Serialization.hpp"
+#include "MemoryAccounting.hpp"
+
+namespace BurpSerialization {
+
+    // Serialization for a root of a known type, calling it directly
+    // rather than through Field. With a StaticObject root the JSON
+    // document and Writer paths make no virtual calls at all.
+    template <class Root>
+    class StaticSerialization {
+
+        public:
+
+            using Mode = Serialization::Mode;
+
+            StaticSerialization(const Root & root, const Mode mode = Mode::collectAll) :
+                _root(root),
+                _mode(mode)
+            {}
+
+            bool serialize(const JsonVariant & dest) const {
+                MemoryAccounting::Scope scope("", dest, MemoryAccounting::Direction::serialize);
+                return _root.Root::serialize(dest);
+            }
+
+            bool serialize(Writer & writer) const {
+                return _root.Root::write(writer);
+            }
+
+            bool serialize(BinaryEncoder & encoder) const {
+                return encoder.encode(_root);
+            }
+
+            BurpStatus::Status::Code deserialize(const JsonVariant & src) {
+                MemoryAccounting::Scope scope("", src, MemoryAccounting::Direction::deserialize);
+                if (_mode == Mode::failFast) return _root.Root::deserializeFailFast(src);
+                return _root.Root::deserialize(src);
+            }
+
+            BurpStatus::Status::Code deserializePatch(const JsonVariant & patch) {
+                MemoryAccounting::Scope scope("", patch, MemoryAccounting::Direction::deserialize);
+                return _root.Root::deserializePatch(patch);
+            }
+
+            BurpStatus::Status::Code deserialize(BinaryDecoder & decoder, const uint8_t * data, const size_t length) {
+                return decoder.decode(_root, data, length);
+            }
+
+        private:
+
+            const Root & _root;
+            const Mode _mode;
+
+    };
+
+}
\ No newline at end of file
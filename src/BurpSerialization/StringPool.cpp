@@ -0,0 +1,63 @@
+#include <string.h>
+#include "StringPool.hpp"
+#include "KeyIndex.hpp"
+
+namespace BurpSerialization
+{
+
+    StringPool::StringPool(char * arena, const size_t arenaSize, Slot * slots, const size_t slotCount) :
+        _arena(arena),
+        _arenaSize(arenaSize),
+        _slots(slots),
+        _slotCount(slotCount)
+    {
+        reset();
+    }
+
+    const char * StringPool::intern(const char * value) {
+        return intern(value, strlen(value));
+    }
+
+    const char * StringPool::intern(const char * value, const size_t length) {
+        _stats.lookups++;
+        if (_slotCount == 0) {
+            _stats.dropped++;
+            return nullptr;
+        }
+        auto hash = hashBytes(reinterpret_cast<const uint8_t *>(value), length, hashSeed);
+        // linear probing, the load limit means there is always an empty slot
+        auto index = hash % _slotCount;
+        while (_slots[index].string != nullptr) {
+            auto & slot = _slots[index];
+            if (slot.hash == hash && strncmp(slot.string, value, length) == 0 && slot.string[length] == '\0') {
+                _stats.hits++;
+                _stats.bytesSaved += length + 1;
+                return slot.string;
+            }
+            index = index + 1 == _slotCount ? 0 : index + 1;
+        }
+        if ((_stats.strings + 1) * 4 > _slotCount * 3 || _stats.bytesUsed + length + 1 > _arenaSize) {
+            _stats.dropped++;
+            return nullptr;
+        }
+        auto string = _arena + _stats.bytesUsed;
+        memcpy(string, value, length);
+        string[length] = '\0';
+        _stats.bytesUsed += length + 1;
+        _stats.strings++;
+        _slots[index] = {hash, string};
+        return string;
+    }
+
+    const StringPool::Stats & StringPool::stats() const {
+        return _stats;
+    }
+
+    void StringPool::reset() {
+        for (size_t index = 0; index < _slotCount; index++) {
+            _slots[index] = {0, nullptr};
+        }
+        _stats = {0, 0, 0, 0, 0, 0};
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace BurpSerialization
+{
+
+    // Interns strings into a caller supplied arena so that each distinct
+    // string is stored once, however many records hold it, and interned
+    // strings from one pool are equal only if their pointers are. An open
+    // addressed table of slots finds existing strings, new ones are bump
+    // allocated from the arena. A CStr given a pool holds interned
+    // pointers, so the JsonDocument can be freed after deserialize.
+    //
+    // Strings are never removed singly, reset() drops them all. Once the
+    // arena is full, or the table 3/4 full, intern() returns nullptr.
+    class StringPool
+    {
+
+    public:
+
+        struct Slot {
+            uint32_t hash;
+            const char * string;
+        };
+
+        // hit rate is hits / lookups
+        struct Stats {
+            size_t lookups;
+            size_t hits;
+            // arena bytes that hits did not need
+            size_t bytesSaved;
+            size_t bytesUsed;
+            size_t strings;
+            // lookups that missed and did not fit
+            size_t dropped;
+        };
+
+        StringPool(char * arena, const size_t arenaSize, Slot * slots, const size_t slotCount);
+
+        // the interned copy of value, nullptr if it is new and does not fit
+        const char * intern(const char * value);
+        // for a value of known length, which need not be null terminated
+        const char * intern(const char * value, const size_t length);
+
+        const Stats & stats() const;
+        // forgets every string, the pointers handed out become invalid
+        void reset();
+
+    private:
+
+        char * const _arena;
+        const size_t _arenaSize;
+        Slot * const _slots;
+        const size_t _slotCount;
+        Stats _stats;
+
+    };
+
+    // A StringPool with its arena and table inline
+    template <size_t arenaSize, size_t slotCount>
+    class StaticStringPool : public StringPool
+    {
+
+    public:
+
+        StaticStringPool() :
+            StringPool(_arena, arenaSize, _slots, slotCount)
+        {}
+
+    private:
+
+        char _arena[arenaSize];
+        Slot _slots[slotCount];
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include <string.h>
+#include "Writer.hpp"
+
+namespace BurpSerialization
+{
+
+    Writer::Writer(char * buffer, const size_t size, const Format format) :
+        _buffer(buffer),
+        _size(size),
+#ifndef BURP_NATIVE
+        _print(nullptr),
+#endif
+        _format(format),
+        _length(0),
+        _failed(size == 0),
+        _needsSeparator(false)
+    {
+        if (size > 0) _buffer[0] = 0;
+    }
+
+#ifndef BURP_NATIVE
+    Writer::Writer(Print & print, const Format format) :
+        _buffer(nullptr),
+        _size(0),
+        _print(&print),
+        _format(format),
+        _length(0),
+        _failed(false),
+        _needsSeparator(false)
+    {}
+#endif
+
+    size_t Writer::write(uint8_t c) {
+        return _raw(static_cast<char>(c)) ? 1 : 0;
+    }
+
+    size_t Writer::write(const uint8_t * data, size_t length) {
+        return _raw(reinterpret_cast<const char *>(data), length) ? length : 0;
+    }
+
+    bool Writer::beginValue() {
+        if (_format == Format::json && _needsSeparator && !_raw(',')) return false;
+        _needsSeparator = true;
+        return !_failed;
+    }
+
+    bool Writer::beginObject(const size_t count) {
+        if (!beginValue()) return false;
+        _needsSeparator = false;
+        if (_format == Format::msgPack) {
+            return _sizeHeader(count, 0x80, 15, 0, 0xde, 0xdf);
+        }
+        return _raw('{');
+    }
+
+    bool Writer::key(const char * name, const size_t length, const bool needsEscape) {
+        if (_format == Format::msgPack) {
+            if (!string(name, length)) return false;
+        } else {
+            if (!beginValue()) return false;
+            if (needsEscape) {
+                if (!_escaped(name)) return false;
+            } else {
+                if (!(_raw('"') && _raw(name, length) && _raw('"'))) return false;
+            }
+            if (!_raw(':')) return false;
+        }
+        _needsSeparator = false;
+        return true;
+    }
+
+    bool Writer::key(const char * name) {
+        return key(name, strlen(name), true);
+    }
+
+    bool Writer::key(const FlashString * name, const size_t length, const bool needsEscape) {
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) {
+            if (!(_sizeHeader(length, 0xa0, 31, 0xd9, 0xda, 0xdb) && _flash(name, length, false))) return false;
+        } else {
+            if (!(_raw('"') && _flash(name, length, needsEscape) && _raw('"') && _raw(':'))) return false;
+        }
+        _needsSeparator = false;
+        return true;
+    }
+
+    bool Writer::endObject() {
+        _needsSeparator = true;
+        if (_format == Format::msgPack) return !_failed;
+        return _raw('}');
+    }
+
+    bool Writer::beginArray(const size_t count) {
+        if (!beginValue()) return false;
+        _needsSeparator = false;
+        if (_format == Format::msgPack) {
+            return _sizeHeader(count, 0x90, 15, 0, 0xdc, 0xdd);
+        }
+        return _raw('[');
+    }
+
+    bool Writer::endArray() {
+        _needsSeparator = true;
+        if (_format == Format::msgPack) return !_failed;
+        return _raw(']');
+    }
+
+    bool Writer::null() {
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) return _raw(static_cast<char>(0xc0));
+        return _raw("null", 4);
+    }
+
+    bool Writer::boolean(const bool value) {
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) return _raw(static_cast<char>(value ? 0xc3 : 0xc2));
+        return value ? _raw("true", 4) : _raw("false", 5);
+    }
+
+    bool Writer::integer(const long long value) {
+        if (value >= 0) {
+            return unsignedInteger(static_cast<unsigned long long>(value));
+        }
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) {
+            if (value >= -32) return _raw(static_cast<char>(value));
+            if (value >= INT8_MIN) return _header(0xd0, static_cast<uint64_t>(value), 1);
+            if (value >= INT16_MIN) return _header(0xd1, static_cast<uint64_t>(value), 2);
+            if (value >= INT32_MIN) return _header(0xd2, static_cast<uint64_t>(value), 4);
+            return _header(0xd3, static_cast<uint64_t>(value), 8);
+        }
+        // negate in unsigned to cope with the minimum value
+        auto magnitude = 0ull - static_cast<unsigned long long>(value);
+        char digits[21];
+        char * pos = digits + sizeof(digits);
+        do {
+            pos--;
+            *pos = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude > 0);
+        pos--;
+        *pos = '-';
+        return _raw(pos, digits + sizeof(digits) - pos);
+    }
+
+    bool Writer::unsignedInteger(unsigned long long value) {
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) {
+            if (value <= 0x7f) return _raw(static_cast<char>(value));
+            if (value <= UINT8_MAX) return _header(0xcc, value, 1);
+            if (value <= UINT16_MAX) return _header(0xcd, value, 2);
+            if (value <= UINT32_MAX) return _header(0xce, value, 4);
+            return _header(0xcf, value, 8);
+        }
+        char digits[20];
+        char * pos = digits + sizeof(digits);
+        do {
+            pos--;
+            *pos = '0' + value % 10;
+            value /= 10;
+        } while (value > 0);
+        return _raw(pos, digits + sizeof(digits) - pos);
+    }
+
+    bool Writer::string(const char * value) {
+        if (_format == Format::msgPack) {
+            return string(value, strlen(value));
+        }
+        return beginValue() && _escaped(value);
+    }
+
+    bool Writer::string(const char * value, const size_t length) {
+        if (!beginValue()) return false;
+        if (_format == Format::msgPack) {
+            return _sizeHeader(length, 0xa0, 31, 0xd9, 0xda, 0xdb) && _raw(value, length);
+        }
+        return _raw('"') && _raw(value, length) && _raw('"');
+    }
+
+    bool Writer::string(const FlashString * value) {
+        if (!beginValue()) return false;
+        auto length = stringLength(value);
+        if (_format == Format::msgPack) {
+            return _sizeHeader(length, 0xa0, 31, 0xd9, 0xda, 0xdb) && _flash(value, length, false);
+        }
+        return _raw('"') && _flash(value, length, true) && _raw('"');
+    }
+
+    bool Writer::binary(const uint8_t * data, const size_t length) {
+        if (_format != Format::msgPack) {
+            _failed = true;
+            return false;
+        }
+        if (!beginValue()) return false;
+        return _sizeHeader(length, 0, 0, 0xc4, 0xc5, 0xc6) && _raw(reinterpret_cast<const char *>(data), length);
+    }
+
+    Writer::Format Writer::format() const {
+        return _format;
+    }
+
+    bool Writer::ok() const {
+        return !_failed;
+    }
+
+    size_t Writer::length() const {
+        return _length;
+    }
+
+    bool Writer::_raw(const char * data, const size_t length) {
+        if (_failed) return false;
+        if (length == 0) return true;
+#ifndef BURP_NATIVE
+        if (_print != nullptr) {
+            if (_print->write(reinterpret_cast<const uint8_t *>(data), length) != length) {
+                _failed = true;
+                return false;
+            }
+            _length += length;
+            return true;
+        }
+#endif
+        // leave room for the terminator
+        if (_length + length >= _size) {
+            _failed = true;
+            return false;
+        }
+        memcpy(_buffer + _length, data, length);
+        _length += length;
+        _buffer[_length] = 0;
+        return true;
+    }
+
+    bool Writer::_raw(const char c) {
+        return _raw(&c, 1);
+    }
+
+    // a type byte followed by a big endian value
+    bool Writer::_header(const uint8_t type, const uint64_t value, const size_t size) {
+        char header[9] = {static_cast<char>(type)};
+        for (size_t index = 0; index < size; index++) {
+            header[size - index] = static_cast<char>(value >> (index * 8));
+        }
+        return _raw(header, size + 1);
+    }
+
+    // fixType is only used when fixMax is not zero and type8 when it is not zero
+    bool Writer::_sizeHeader(const size_t count, const uint8_t fixType, const size_t fixMax, const uint8_t type8, const uint8_t type16, const uint8_t type32) {
+        if (fixMax > 0 && count <= fixMax) return _raw(static_cast<char>(fixType | count));
+        if (type8 != 0 && count <= UINT8_MAX) return _header(type8, count, 1);
+        if (count <= UINT16_MAX) return _header(type16, count, 2);
+        return _header(type32, count, 4);
+    }
+
+    bool Writer::_escaped(const char * value) {
+        return _raw('"') && _escapedRun(value) && _raw('"');
+    }
+
+    // escapes without the quotes
+    bool Writer::_escapedRun(const char * value) {
+        auto start = value;
+        auto pos = value;
+        for (; *pos; pos++) {
+            auto c = static_cast<uint8_t>(*pos);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            // flush the plain run before the escape
+            if (!_raw(start, pos - start)) return false;
+            start = pos + 1;
+            char escape = 0;
+            switch (c) {
+                case '"': escape = '"'; break;
+                case '\\': escape = '\\'; break;
+                case '\b': escape = 'b'; break;
+                case '\f': escape = 'f'; break;
+                case '\n': escape = 'n'; break;
+                case '\r': escape = 'r'; break;
+                case '\t': escape = 't'; break;
+            }
+            if (escape) {
+                const char sequence[] = {'\\', escape};
+                if (!_raw(sequence, sizeof(sequence))) return false;
+            } else {
+                const char hex[] = "0123456789abcdef";
+                const char sequence[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0f]};
+                if (!_raw(sequence, sizeof(sequence))) return false;
+            }
+        }
+        return _raw(start, pos - start);
+    }
+
+    bool Writer::_flash(const FlashString * value, const size_t length, const bool escape) {
+        auto src = reinterpret_cast<const char *>(value);
+        char chunk[32 + 1];
+        for (size_t offset = 0; offset < length; offset += 32) {
+            auto size = length - offset < 32 ? length - offset : 32;
+            flashRead(chunk, src + offset, size);
+            chunk[size] = 0;
+            if (!(escape ? _escapedRun(chunk) : _raw(chunk, size))) return false;
+        }
+        return true;
+    }
+
+}
\ No newline at end of file
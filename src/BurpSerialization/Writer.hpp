@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Flash.hpp"
+#ifndef BURP_NATIVE
+#include <Print.h>
+#endif
+
+namespace BurpSerialization
+{
+
+    // Output for Field::write, as JSON text or MessagePack, either to a
+    // fixed buffer (which is kept null terminated) or to a Print. Value
+    // separators are inserted as needed. Once a write fails the writer
+    // stays failed.
+    class Writer
+    {
+
+    public:
+
+        enum class Format : uint8_t {
+            json,
+            msgPack
+        };
+
+        Writer(char * buffer, const size_t size, const Format format = Format::json);
+#ifndef BURP_NATIVE
+        explicit Writer(Print & print, const Format format = Format::json);
+#endif
+
+        // the interface ArduinoJson expects from a custom writer, raw output
+        size_t write(uint8_t c);
+        size_t write(const uint8_t * data, size_t length);
+
+        // call before writing a value through the raw interface
+        bool beginValue();
+
+        bool beginObject(const size_t count);
+        // a key with its length and whether it needs escaping worked out
+        bool key(const char * name, const size_t length, const bool needsEscape);
+        bool key(const char * name);
+        // the same for a name in flash
+        bool key(const FlashString * name, const size_t length, const bool needsEscape);
+        bool endObject();
+        bool beginArray(const size_t count);
+        bool endArray();
+
+        bool null();
+        bool boolean(const bool value);
+        bool integer(const long long value);
+        bool unsignedInteger(unsigned long long value);
+        // quoted and escaped
+        bool string(const char * value);
+        // a string known not to need escaping
+        bool string(const char * value, const size_t length);
+        // quoted and escaped, copied out of flash a chunk at a time
+        bool string(const FlashString * value);
+        // MessagePack only
+        bool binary(const uint8_t * data, const size_t length);
+
+        Format format() const;
+        bool ok() const;
+        size_t length() const;
+
+    private:
+
+        char * const _buffer;
+        const size_t _size;
+#ifndef BURP_NATIVE
+        Print * const _print;
+#endif
+        const Format _format;
+        size_t _length;
+        bool _failed;
+        bool _needsSeparator;
+
+        bool _raw(const char * data, const size_t length);
+        bool _raw(const char c);
+        bool _header(const uint8_t type, const uint64_t value, const size_t size);
+        bool _sizeHeader(const size_t count, const uint8_t fixType, const size_t fixMax, const uint8_t type8, const uint8_t type16, const uint8_t type32);
+        bool _escaped(const char * value);
+        bool _escapedRun(const char * value);
+        bool _flash(const FlashString * value, const size_t length, const bool escape);
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include <unity.h>
+#include <string.h>
+#include "../src/BurpSerialization/Array.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/CachedIPv4.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/Parser.hpp"
+#include "../src/BurpSerialization/BinaryDecoder.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "Array.hpp"
+
+namespace Array {
+
+    constexpr size_t docSize = 512;
+    constexpr size_t bufferSize = 128;
+    constexpr size_t smallBufferSize = 4;
+    constexpr size_t maxLength = 4;
+    constexpr size_t fingerprintSize = 4;
+    constexpr char fieldName[] = "field";
+    constexpr char validJson[] = "[1,2,3]";
+    constexpr char validIPv4Json[] = "[\"10.0.0.1\",\"192.168.1.254\"]";
+    constexpr char validObjectJson[] = "[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]";
+
+    enum : BurpStatus::Status::Code {
+        ok,
+        notPresent,
+        wrongType,
+        tooShort,
+        tooLong,
+        elementNotPresent,
+        elementWrongType,
+        elementInvalid
+    };
+
+    using Int = BurpSerialization::Scalar<int>;
+    using Ints = BurpSerialization::Array<Int, maxLength>;
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            Ints::Value ints;
+
+            Serialization(const Mode mode = Mode::collectAll) :
+                BurpSerialization::Serialization(_ints, mode),
+                _int({ok, elementNotPresent, elementWrongType}, _element),
+                _ints(2, {ok, notPresent, wrongType, tooShort, tooLong}, _int, _element, ints)
+            {}
+
+            const BurpSerialization::Field & root() const {
+                return _ints;
+            }
+
+        private:
+
+            Int::Value _element;
+            const Int _int;
+            const Ints _ints;
+
+    };
+
+    // elements that are allowed to be null
+    class NullableSerialization : public BurpSerialization::Serialization {
+
+        public:
+
+            Ints::Value ints;
+
+            NullableSerialization() :
+                BurpSerialization::Serialization(_ints),
+                _int({ok, ok, elementWrongType}, _element),
+                _ints(0, {ok, notPresent, wrongType, tooShort, tooLong}, _int, _element, ints),
+                _decoder(_strings, bufferSize, {ok, 100, 101, 102, 103})
+            {}
+
+            BurpStatus::Status::Code decode(const uint8_t * data, size_t length) {
+                return deserialize(_decoder, data, length);
+            }
+
+        private:
+
+            Int::Value _element;
+            const Int _int;
+            const Ints _ints;
+            char _strings[bufferSize];
+            BurpSerialization::BinaryDecoder _decoder;
+
+    };
+
+    using IPv4s = BurpSerialization::Array<BurpSerialization::IPv4, maxLength>;
+
+    class IPv4Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            IPv4s::Value addresses;
+
+            IPv4Serialization() :
+                BurpSerialization::Serialization(_addresses),
+                _address({ok, elementNotPresent, elementWrongType, elementInvalid, elementInvalid, elementInvalid, elementInvalid}, _element),
+                _addresses(1, {ok, notPresent, wrongType, tooShort, tooLong}, _address, _element, addresses)
+            {}
+
+        private:
+
+            BurpSerialization::IPv4::Value _element;
+            const BurpSerialization::IPv4 _address;
+            const IPv4s _addresses;
+
+    };
+
+    using CachedIPv4s = BurpSerialization::Array<BurpSerialization::CachedIPv4, maxLength>;
+
+    // one cached field and scratch value for every element
+    class CachedIPv4Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            CachedIPv4s::Value addresses;
+
+            CachedIPv4Serialization() :
+                BurpSerialization::Serialization(_addresses),
+                _address({ok, elementNotPresent, elementWrongType, elementInvalid, elementInvalid, elementInvalid, elementInvalid}, _element),
+                _addresses(1, {ok, notPresent, wrongType, tooShort, tooLong}, _address, _element, addresses)
+            {}
+
+        private:
+
+            BurpSerialization::CachedIPv4::Value _element;
+            const BurpSerialization::CachedIPv4 _address;
+            const CachedIPv4s _addresses;
+
+    };
+
+    // {"ints": [int], "after": int}
+    template <size_t maxInts>
+    class TrailingSerialization : public BurpSerialization::Serialization {
+
+        public:
+
+            using Ints = BurpSerialization::Array<Int, maxInts>;
+            using Pair = BurpSerialization::Object<2>;
+
+            struct {
+                bool isNull;
+                typename Ints::Value ints;
+                Int::Value after;
+            } obj = {};
+
+            TrailingSerialization() :
+                BurpSerialization::Serialization(_obj),
+                _int({ok, elementNotPresent, elementWrongType}, _element),
+                _ints(0, {ok, notPresent, wrongType, tooShort, tooLong}, _int, _element, obj.ints),
+                _after({ok, notPresent, wrongType}, obj.after),
+                _obj({
+                    Pair::Entry({"ints", &_ints}),
+                    Pair::Entry({"after", &_after})
+                }, {ok, notPresent, wrongType}, obj.isNull),
+                _decoder(_strings, bufferSize, {ok, 100, 101, 102, 103})
+            {}
+
+            BurpStatus::Status::Code decode(const uint8_t * data, size_t length) {
+                return deserialize(_decoder, data, length);
+            }
+
+        private:
+
+            Int::Value _element;
+            const Int _int;
+            const Ints _ints;
+            const Int _after;
+            const Pair _obj;
+            char _strings[bufferSize];
+            BurpSerialization::BinaryDecoder _decoder;
+
+    };
+
+    // {"x": int, "y": int}
+    struct Point {
+        bool isNull;
+        Int::Value x;
+        Int::Value y;
+    };
+
+    using Pair = BurpSerialization::Object<2>;
+    using Points = BurpSerialization::Array<Pair, maxLength, BurpSerialization::CopiedCodes, Point>;
+
+    class PointSerialization : public BurpSerialization::Serialization {
+
+        public:
+
+            Points::Value points;
+
+            PointSerialization() :
+                BurpSerialization::Serialization(_points),
+                _x({ok, elementNotPresent, elementWrongType}, _element.x),
+                _y({ok, elementNotPresent, elementWrongType}, _element.y),
+                _point({
+                    Pair::Entry({"x", &_x}),
+                    Pair::Entry({"y", &_y})
+                }, {ok, elementNotPresent, elementWrongType}, _element.isNull),
+                _points(1, {ok, notPresent, wrongType, tooShort, tooLong}, _point, _element, points)
+            {}
+
+            const BurpSerialization::Field & root() const {
+                return _points;
+            }
+
+        private:
+
+            Point _element;
+            const Int _x;
+            const Int _y;
+            const Pair _point;
+            const Points _points;
+
+    };
+
+    BurpStatus::Status::Code parse(const BurpSerialization::Field & field, const char * json) {
+        char buffer[bufferSize];
+        BurpSerialization::Parser parser(field, buffer, bufferSize, {ok, 100, 101, 102, 103});
+        parser.begin();
+        parser.write(json, strlen(json));
+        return parser.end();
+    }
+
+    Module tests("Array", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("when not present", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<1> doc;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(notPresent, code);
+                });
+            });
+            d.describe("with an invalid value", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = 1;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(wrongType, code);
+                });
+            });
+            d.describe("when the array is too long", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "[1,2,3,4,5]");
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(tooLong, code);
+                });
+            });
+            d.describe("when the array is too short", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "[1]");
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(tooShort, code);
+                });
+            });
+            d.describe("when an element is invalid", [](Describe & d) {
+                d.it("should fail with the element code", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "[1,\"two\",null]");
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(elementWrongType, code);
+                });
+            });
+            d.describe("with a valid array", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validJson);
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_FALSE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.length);
+                    TEST_ASSERT_EQUAL(1, serialization.ints.list[0].value);
+                    TEST_ASSERT_EQUAL(2, serialization.ints.list[1].value);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.list[2].value);
+                    TEST_ASSERT_EQUAL(ok, code);
+                });
+            });
+            d.describe("with IPv4 elements", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    IPv4Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validIPv4Json);
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL(2, serialization.addresses.length);
+                    TEST_ASSERT_EQUAL(0x0a000001, serialization.addresses.list[0].value);
+                    TEST_ASSERT_EQUAL(0xc0a801fe, serialization.addresses.list[1].value);
+                    TEST_ASSERT_EQUAL(ok, code);
+                });
+            });
+            d.describe("with Object elements", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    PointSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validObjectJson);
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL(2, serialization.points.length);
+                    TEST_ASSERT_EQUAL(1, serialization.points.list[0].x.value);
+                    TEST_ASSERT_EQUAL(4, serialization.points.list[1].y.value);
+                    TEST_ASSERT_EQUAL(ok, code);
+                });
+            });
+        });
+
+        d.describe("deserialize fail fast", [](Describe & d) {
+            d.describe("when an element is invalid", [](Describe & d) {
+                d.it("should fail with the first bad element", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "[1,null,\"three\"]");
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(elementNotPresent, code);
+                });
+            });
+        });
+
+        d.describe("Parser", [](Describe & d) {
+            d.describe("with a valid array", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization;
+                    auto code = parse(serialization.root(), validJson);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.length);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.list[2].value);
+                    TEST_ASSERT_EQUAL(ok, code);
+                });
+            });
+            d.describe("with Object elements", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    PointSerialization serialization;
+                    auto code = parse(serialization.root(), validObjectJson);
+                    TEST_ASSERT_EQUAL(2, serialization.points.length);
+                    TEST_ASSERT_EQUAL(3, serialization.points.list[1].x.value);
+                    TEST_ASSERT_EQUAL(ok, code);
+                });
+            });
+            d.describe("when the array is too long", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    auto code = parse(serialization.root(), "[1,2,3,4,5]");
+                    TEST_ASSERT_TRUE(serialization.ints.isNull);
+                    TEST_ASSERT_EQUAL(tooLong, code);
+                });
+            });
+        });
+
+        d.describe("serialize", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should be null", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.ints.isNull = true;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(doc[fieldName].isNull());
+                });
+            });
+            d.describe("with Object elements", [](Describe & d) {
+                d.it("should serialize every element", []() {
+                    PointSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validObjectJson);
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    StaticJsonDocument<docSize> out;
+                    auto success = serialization.serialize(out.to<JsonVariant>());
+                    char buffer[bufferSize];
+                    serializeJson(out, buffer, bufferSize);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validObjectJson, buffer);
+                });
+            });
+            d.describe("with CachedIPv4 elements", [](Describe & d) {
+                d.it("should keep the text of every element", []() {
+                    CachedIPv4Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validIPv4Json);
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    StaticJsonDocument<docSize> out;
+                    auto success = serialization.serialize(out.to<JsonVariant>());
+                    char buffer[bufferSize];
+                    serializeJson(out, buffer, bufferSize);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validIPv4Json, buffer);
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    IPv4Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validIPv4Json);
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    TEST_ASSERT_FALSE(serialization.serialize(writer));
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the elements", []() {
+                    IPv4Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validIPv4Json);
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    TEST_ASSERT_TRUE(serialization.serialize(writer));
+                    TEST_ASSERT_EQUAL_STRING(validIPv4Json, buffer);
+                });
+            });
+        });
+
+        d.describe("binary", [](Describe & d) {
+            d.describe("with null elements", [](Describe & d) {
+                d.it("should read back the same values", []() {
+                    NullableSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "[1,null,3]");
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    uint8_t buffer[bufferSize];
+                    BurpSerialization::BinaryEncoder encoder(buffer, bufferSize);
+                    TEST_ASSERT_TRUE(serialization.serialize(encoder));
+                    serialization.ints = {};
+                    auto code = serialization.decode(buffer, encoder.length());
+                    TEST_ASSERT_EQUAL(ok, code);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.length);
+                    TEST_ASSERT_EQUAL(1, serialization.ints.list[0].value);
+                    TEST_ASSERT_TRUE(serialization.ints.list[1].isNull);
+                    TEST_ASSERT_EQUAL(3, serialization.ints.list[2].value);
+                });
+            });
+            d.describe("when the array is too long", [](Describe & d) {
+                d.it("should fail and still decode the fields after it", []() {
+                    TrailingSerialization<maxLength + 1> longer;
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, "{\"ints\":[1,2,3,4,5],\"after\":7}");
+                    longer.deserialize(doc.as<JsonVariant>());
+                    uint8_t buffer[bufferSize];
+                    BurpSerialization::BinaryEncoder encoder(buffer, bufferSize);
+                    TEST_ASSERT_TRUE(longer.serialize(encoder));
+                    // the same bytes under the shorter schema's fingerprint
+                    TrailingSerialization<maxLength> serialization;
+                    uint8_t header[bufferSize];
+                    BurpSerialization::BinaryEncoder headerEncoder(header, bufferSize);
+                    TEST_ASSERT_TRUE(serialization.serialize(headerEncoder));
+                    memcpy(buffer, header, fingerprintSize);
+                    auto code = serialization.decode(buffer, encoder.length());
+                    TEST_ASSERT_EQUAL(tooLong, code);
+                    TEST_ASSERT_TRUE(serialization.obj.ints.isNull);
+                    TEST_ASSERT_EQUAL(7, serialization.obj.after.value);
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
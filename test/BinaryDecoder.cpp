@@ -0,0 +1,437 @@
+#include <unity.h>
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/CStrMap.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "TestField.hpp"
+#include "BinaryDecoder.hpp"
+
+namespace BinaryDecoder {
+
+    constexpr size_t bufferSize = 128;
+    constexpr size_t smallBufferSize = 8;
+    constexpr size_t jsonBufferSize = 256;
+    constexpr size_t headerSize = 5;
+    constexpr char nameName[] = "name";
+    constexpr char countName[] = "count";
+    constexpr char modeName[] = "mode";
+    constexpr char levelsName[] = "levels";
+    constexpr char addressName[] = "address";
+    constexpr char macName[] = "mac";
+    constexpr char ratioName[] = "ratio";
+    constexpr char innerName[] = "inner";
+    constexpr char labelName[] = "label";
+    constexpr char choiceOne[] = "one";
+    constexpr char choiceTwo[] = "two";
+    constexpr char choiceThree[] = "three";
+    constexpr char validName[] = "ab";
+    constexpr int16_t validCount = -2;
+    constexpr uint8_t validMode = 30;
+    constexpr uint32_t validAddress = 0xc0a80101;
+    constexpr uint8_t validMac[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab};
+    constexpr float validRatio = 0.5;
+    constexpr char validLabel[] = "a \"label\"";
+    // after the header: bitmap, name, count, mode, levels, address, mac,
+    // ratio and then the inner bitmap and the label as JSON text
+    constexpr uint8_t validLayout[] = {
+        0xff,
+        0x02, 'a', 'b',
+        0xfe, 0xff,
+        0x02,
+        0x03, 0x01, 0x02, 0x03,
+        0xc0, 0xa8, 0x01, 0x01,
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+        0x00, 0x00, 0x00, 0x3f,
+        0x01,
+        0x0d, '"', 'a', ' ', '\\', '"', 'l', 'a', 'b', 'e', 'l', '\\', '"', '"'
+    };
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                schemaMismatch,
+                truncated,
+                invalidInput,
+                noMemory,
+                notPresent,
+                wrongType,
+                nameNotPresent,
+                nameWrongType,
+                nameTooShort,
+                nameTooLong,
+                countNotPresent,
+                countWrongType,
+                modeNotPresent,
+                modeWrongType,
+                modeInvalidChoice,
+                levelsNotPresent,
+                levelsWrongType,
+                levelsTooLong,
+                levelsTooShort,
+                levelZero,
+                levelNotIncreasing,
+                levelNotPresent,
+                levelWrongType,
+                addressNotPresent,
+                addressWrongType,
+                addressInvalidCharacter,
+                addressOutOfRange,
+                addressMissingField,
+                addressExcessCharacters,
+                macNotPresent,
+                macWrongType,
+                macInvalidCharacter,
+                macInvalidSeparator,
+                macOutOfRange,
+                macMissingField,
+                macExcessCharacters,
+                ratioNotPresent,
+                ratioWrongType,
+                innerNotPresent,
+                innerWrongType,
+                labelNotPresent,
+                labelWrongType
+            };
+
+            struct {
+                bool isNull;
+                const char * name;
+                BurpSerialization::Scalar<int16_t>::Value count;
+                BurpSerialization::CStrMap<uint8_t, 3>::Value mode;
+                BurpSerialization::PWMLevels::Value levels;
+                BurpSerialization::IPv4::Value address;
+                BurpSerialization::MacAddress::Value mac;
+                BurpSerialization::Scalar<float>::Value ratio;
+                struct {
+                    bool isNull;
+                    const char * label;
+                } inner;
+            } obj;
+
+            Serialization() :
+                BurpSerialization::Serialization(_obj),
+                _name(1, 16, {
+                    ok,
+                    nameNotPresent,
+                    nameWrongType,
+                    nameTooShort,
+                    nameTooLong
+                }, obj.name),
+                _count({
+                    ok,
+                    countNotPresent,
+                    countWrongType
+                }, obj.count),
+                _mode({
+                    Mode::Choice({choiceOne, 10}),
+                    Mode::Choice({choiceTwo, 20}),
+                    Mode::Choice({choiceThree, 30})
+                }, {
+                    ok,
+                    modeNotPresent,
+                    modeWrongType,
+                    modeInvalidChoice
+                }, obj.mode),
+                _levels({
+                    ok,
+                    levelsNotPresent,
+                    levelsWrongType,
+                    levelsTooLong,
+                    levelsTooShort,
+                    levelZero,
+                    levelNotIncreasing,
+                    levelNotPresent,
+                    levelWrongType
+                }, obj.levels),
+                _address({
+                    ok,
+                    addressNotPresent,
+                    addressWrongType,
+                    addressInvalidCharacter,
+                    addressOutOfRange,
+                    addressMissingField,
+                    addressExcessCharacters
+                }, obj.address),
+                _mac({
+                    ok,
+                    macNotPresent,
+                    macWrongType,
+                    macInvalidCharacter,
+                    macInvalidSeparator,
+                    macOutOfRange,
+                    macMissingField,
+                    macExcessCharacters
+                }, obj.mac),
+                _ratio({
+                    ok,
+                    ratioNotPresent,
+                    ratioWrongType
+                }, obj.ratio),
+                _label({
+                    ok,
+                    labelNotPresent,
+                    labelWrongType
+                }, obj.inner.label),
+                _inner({
+                    Inner::Entry({labelName, &_label})
+                }, {
+                    ok,
+                    innerNotPresent,
+                    innerWrongType
+                }, obj.inner.isNull),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count}),
+                    Object::Entry({modeName, &_mode}),
+                    Object::Entry({levelsName, &_levels}),
+                    Object::Entry({addressName, &_address}),
+                    Object::Entry({macName, &_mac}),
+                    Object::Entry({ratioName, &_ratio}),
+                    Object::Entry({innerName, &_inner})
+                }, {
+                    ok,
+                    notPresent,
+                    wrongType
+                }, obj.isNull),
+                _decoder(_strings, bufferSize, {
+                    ok,
+                    schemaMismatch,
+                    truncated,
+                    invalidInput,
+                    noMemory
+                })
+            {}
+
+            void setValid() {
+                obj.isNull = false;
+                obj.name = validName;
+                obj.count.isNull = false;
+                obj.count.value = validCount;
+                obj.mode.isNull = false;
+                obj.mode.value = validMode;
+                obj.levels.isNull = false;
+                obj.levels.list = {1, 2, 3};
+                obj.levels.length = 3;
+                obj.address.isNull = false;
+                obj.address.value = validAddress;
+                obj.mac.isNull = false;
+                memcpy(obj.mac.value, validMac, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                obj.ratio.isNull = false;
+                obj.ratio.value = validRatio;
+                obj.inner.isNull = false;
+                obj.inner.label = validLabel;
+            }
+
+            BurpStatus::Status::Code decode(const uint8_t * data, size_t length) {
+                obj = {};
+                return deserialize(_decoder, data, length);
+            }
+
+        private:
+
+            using Mode = BurpSerialization::CStrMap<uint8_t, 3>;
+            using Inner = BurpSerialization::Object<1>;
+            using Object = BurpSerialization::Object<8>;
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::Scalar<int16_t> _count;
+            const Mode _mode;
+            const BurpSerialization::PWMLevels _levels;
+            const BurpSerialization::IPv4 _address;
+            const BurpSerialization::MacAddress _mac;
+            const BurpSerialization::Scalar<float> _ratio;
+            const TestField _label;
+            const Inner _inner;
+            const Object _obj;
+            char _strings[bufferSize];
+            BurpSerialization::BinaryDecoder _decoder;
+
+    };
+
+    // the same keys with a different layout
+    class OtherSerialization : public BurpSerialization::Serialization {
+
+        public:
+
+            bool isNull = false;
+            const char * name = validName;
+            BurpSerialization::Scalar<int32_t>::Value count;
+
+            OtherSerialization() :
+                BurpSerialization::Serialization(_obj),
+                _name(1, 16, {0, 1, 2, 3, 4}, name),
+                _count({0, 1, 2}, count),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count})
+                }, {0, 1, 2}, isNull)
+            {}
+
+        private:
+
+            using Object = BurpSerialization::Object<2>;
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::Scalar<int32_t> _count;
+            const Object _obj;
+
+    };
+
+    size_t encode(const BurpSerialization::Serialization & serialization, uint8_t * buffer, size_t size) {
+        BurpSerialization::BinaryEncoder encoder(buffer, size);
+        if (!serialization.serialize(encoder)) return 0;
+        return encoder.length();
+    }
+
+    Module tests("BinaryDecoder", [](Describe & d) {
+        d.describe("with an encoded document", [](Describe & d) {
+            d.it("should read back the same values", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                TEST_ASSERT_NOT_EQUAL(0, length);
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::ok, code);
+                TEST_ASSERT_FALSE(serialization.obj.isNull);
+                TEST_ASSERT_EQUAL_STRING(validName, serialization.obj.name);
+                TEST_ASSERT_EQUAL(validCount, serialization.obj.count.value);
+                TEST_ASSERT_EQUAL(validMode, serialization.obj.mode.value);
+                TEST_ASSERT_EQUAL(3, serialization.obj.levels.length);
+                TEST_ASSERT_EQUAL(3, serialization.obj.levels.list[2]);
+                TEST_ASSERT_EQUAL(validAddress, serialization.obj.address.value);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(validMac, serialization.obj.mac.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                TEST_ASSERT_TRUE(validRatio == serialization.obj.ratio.value);
+                TEST_ASSERT_FALSE(serialization.obj.inner.isNull);
+                TEST_ASSERT_EQUAL_STRING(validLabel, serialization.obj.inner.label);
+            });
+        });
+        d.describe("encoding a document", [](Describe & d) {
+            d.it("should write the positional layout after the header", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                TEST_ASSERT_EQUAL(headerSize + sizeof(validLayout), length);
+                TEST_ASSERT_EQUAL(1, buffer[headerSize - 1]);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(validLayout, buffer + headerSize, sizeof(validLayout));
+            });
+        });
+        d.describe("encoding a document with null values", [](Describe & d) {
+            d.it("should leave them out and read them back as not present", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                serialization.obj.count.isNull = true;
+                serialization.obj.inner.isNull = true;
+                auto length = encode(serialization, buffer, bufferSize);
+                TEST_ASSERT_EQUAL(headerSize + sizeof(validLayout) - 2 - 15, length);
+                TEST_ASSERT_EQUAL(0x7d, buffer[headerSize]);
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::innerNotPresent, code);
+                TEST_ASSERT_TRUE(serialization.obj.count.isNull);
+                TEST_ASSERT_TRUE(serialization.obj.inner.isNull);
+                TEST_ASSERT_EQUAL_STRING(validName, serialization.obj.name);
+            });
+        });
+        d.describe("encoding a null root", [](Describe & d) {
+            d.it("should read back as not present", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.obj.isNull = true;
+                auto length = encode(serialization, buffer, bufferSize);
+                TEST_ASSERT_EQUAL(headerSize, length);
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::notPresent, code);
+                TEST_ASSERT_TRUE(serialization.obj.isNull);
+            });
+        });
+        d.describe("with a buffer that is too small to encode", [](Describe & d) {
+            d.it("should fail", []() {
+                Serialization serialization;
+                uint8_t buffer[smallBufferSize];
+                serialization.setValid();
+                BurpSerialization::BinaryEncoder encoder(buffer, smallBufferSize);
+                TEST_ASSERT_FALSE(serialization.serialize(encoder));
+                TEST_ASSERT_FALSE(encoder.ok());
+            });
+        });
+        d.describe("with a different schema", [](Describe & d) {
+            d.it("should fail on the fingerprint", []() {
+                Serialization serialization;
+                OtherSerialization other;
+                uint8_t buffer[bufferSize];
+                other.count.value = validCount;
+                auto length = encode(other, buffer, bufferSize);
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::schemaMismatch, code);
+            });
+        });
+        d.describe("with a truncated document", [](Describe & d) {
+            d.it("should fail", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                auto code = serialization.decode(buffer, length - 1);
+                TEST_ASSERT_EQUAL(Serialization::truncated, code);
+            });
+        });
+        d.describe("with trailing data", [](Describe & d) {
+            d.it("should fail", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                buffer[length] = 0;
+                auto code = serialization.decode(buffer, length + 1);
+                TEST_ASSERT_EQUAL(Serialization::invalidInput, code);
+            });
+        });
+        d.describe("with a choice index out of range", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                // the mode index follows the bitmap, name and count
+                buffer[headerSize + 6] = 3;
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::modeInvalidChoice, code);
+                TEST_ASSERT_TRUE(serialization.obj.mode.isNull);
+            });
+        });
+        d.describe("with a string that is too long for the field", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                serialization.setValid();
+                serialization.obj.name = "a name that is far too long";
+                auto length = encode(serialization, buffer, bufferSize);
+                auto code = serialization.decode(buffer, length);
+                TEST_ASSERT_EQUAL(Serialization::nameTooLong, code);
+                TEST_ASSERT_NULL(serialization.obj.name);
+            });
+        });
+        d.describe("compared to JSON", [](Describe & d) {
+            d.it("should be smaller", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                char json[jsonBufferSize];
+                serialization.setValid();
+                auto length = encode(serialization, buffer, bufferSize);
+                BurpSerialization::Writer writer(json, jsonBufferSize);
+                TEST_ASSERT_TRUE(serialization.serialize(writer));
+                TEST_ASSERT_LESS_THAN(writer.length() / 2, length);
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 namespace CStr {
 
     constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 4;
     constexpr size_t minLength = 5;
     constexpr size_t maxLength = 10;
     constexpr char fieldName[] = "field";
@@ -141,6 +143,52 @@ namespace CStr {
                 });
             });
         });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    serialization.cstr = maxCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstr = nullptr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstr = maxCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"0123456789\"", buffer);
+                });
+            });
+            d.describe("with characters that need escaping", [](Describe & d) {
+                d.it("should escape them", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstr = "a\"b\\c\nd";
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"a\\\"b\\\\c\\nd\"", buffer);
+                });
+            });
+        });
     });
 
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <unity.h>
+#include <stdio.h>
 #include "../src/BurpSerialization/CStrMap.hpp"
 #include "../src/BurpSerialization/Serialization.hpp"
 #include "CStrMap.hpp"
@@ -6,6 +7,8 @@
 namespace CStrMap {
 
     constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 4;
     constexpr size_t choiceCount = 3;
     constexpr char fieldName[] = "field";
     constexpr char choiceOne[] = "one";
@@ -24,6 +27,47 @@ namespace CStrMap {
         Map::Choice({choiceThree, valueThree})
     };
 
+    enum class Sparse : uint8_t {
+        one = 1,
+        ten = 10,
+        hundred = 100,
+        invalid = 50
+    };
+    using SparseMap = BurpSerialization::CStrMap<Sparse, choiceCount>;
+    SparseMap::Choices sparseChoices = {
+        SparseMap::Choice({choiceOne, Sparse::one}),
+        SparseMap::Choice({choiceTwo, Sparse::ten}),
+        SparseMap::Choice({choiceThree, Sparse::hundred})
+    };
+
+    // keys in flash, one long enough to be written in more than one chunk
+    const char flashOne[] PROGMEM = "one";
+    const char flashTwo[] PROGMEM = "two";
+    const char flashLong[] PROGMEM = "a \"long\" key written out of flash in more than one chunk";
+    constexpr char longJson[] = "\"a \\\"long\\\" key written out of flash in more than one chunk\"";
+    using FlashMap = BurpSerialization::CStrMap<uint8_t, choiceCount, BurpSerialization::CopiedCodes, const BurpSerialization::FlashString *>;
+    FlashMap::Choices flashChoices = {
+        FlashMap::Choice({BurpSerialization::flashString(flashOne), valueOne}),
+        FlashMap::Choice({BurpSerialization::flashString(flashTwo), valueTwo}),
+        FlashMap::Choice({BurpSerialization::flashString(flashLong), valueThree})
+    };
+
+    // more choices than a byte can index, with sparse values
+    constexpr size_t wideCount = 300;
+    constexpr size_t wideKeyLength = 8;
+    using WideMap = BurpSerialization::CStrMap<uint16_t, wideCount>;
+    char wideKeys[wideCount][wideKeyLength];
+
+    WideMap::Choices wideChoices() {
+        WideMap::Choices choices;
+        for (size_t index = 0; index < wideCount; index++) {
+            snprintf(wideKeys[index], wideKeyLength, "k%u", static_cast<unsigned>(index));
+            // in reverse order, so sorting by value moves every choice
+            choices[index] = {wideKeys[index], static_cast<uint16_t>((wideCount - index) * 3)};
+        }
+        return choices;
+    }
+
     class Serialization : public BurpSerialization::Serialization {
 
         public:
@@ -146,6 +190,135 @@ namespace CStrMap {
                     });
                 }
             });
+            d.describe("with sparse enum values", [](Describe & d) {
+                d.it("should set the matching key in the JSON document", []() {
+                    SparseMap::Value value;
+                    SparseMap sparseMap(sparseChoices, {
+                        Serialization::ok,
+                        Serialization::notPresent,
+                        Serialization::wrongType,
+                        Serialization::invalidChoice
+                    }, value);
+                    StaticJsonDocument<docSize> doc;
+                    value.value = Sparse::ten;
+                    auto success = sparseMap.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(choiceTwo, doc[fieldName]);
+                    value.value = Sparse::invalid;
+                    success = sparseMap.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("with more choices than a byte can index", [](Describe & d) {
+                d.it("should set the matching key in the JSON document", []() {
+                    WideMap::Value value;
+                    WideMap wideMap(wideChoices(), {
+                        Serialization::ok,
+                        Serialization::notPresent,
+                        Serialization::wrongType,
+                        Serialization::invalidChoice
+                    }, value);
+                    StaticJsonDocument<docSize> doc;
+                    value.value = 3;
+                    auto success = wideMap.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("k299", doc[fieldName]);
+                    value.value = (wideCount - 7) * 3;
+                    success = wideMap.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("k7", doc[fieldName]);
+                    value.value = 4;
+                    success = wideMap.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    serialization.cstrMap.value = valueThree;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstrMap.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstrMap.value = valueThree;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"three\"", buffer);
+                });
+            });
+        });
+
+        d.describe("with keys in flash", [](Describe & d) {
+            d.describe("deserialize a valid choice", [](Describe & d) {
+                d.it("should have the correct value", []() {
+                    FlashMap::Value value;
+                    FlashMap map(flashChoices, {0, 1, 2, 3}, value);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = choiceTwo;
+                    auto code = map.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(value.isNull);
+                    TEST_ASSERT_EQUAL(valueTwo, value.value);
+                    TEST_ASSERT_EQUAL(0, code);
+                });
+            });
+            d.describe("deserialize an invalid choice", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    FlashMap::Value value;
+                    FlashMap map(flashChoices, {0, 1, 2, 3}, value);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = invalidChoice;
+                    auto code = map.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(value.isNull);
+                    TEST_ASSERT_EQUAL(3, code);
+                });
+            });
+            d.describe("serialize", [](Describe & d) {
+                d.it("should copy the key into the JSON document", []() {
+                    FlashMap::Value value;
+                    FlashMap map(flashChoices, {0, 1, 2, 3}, value);
+                    StaticJsonDocument<docSize> doc;
+                    value.isNull = false;
+                    value.value = valueOne;
+                    auto success = map.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(choiceOne, doc[fieldName].as<const char *>());
+                    TEST_ASSERT_TRUE(doc[fieldName].as<const char *>() != flashOne);
+                });
+            });
+            d.describe("write a long key that needs escaping", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    FlashMap::Value value;
+                    FlashMap map(flashChoices, {0, 1, 2, 3}, value);
+                    char buffer[bufferSize + bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize + bufferSize);
+                    value.isNull = false;
+                    value.value = valueThree;
+                    auto success = map.write(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(longJson, buffer);
+                });
+            });
         });
     });
 
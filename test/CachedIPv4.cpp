@@ -0,0 +1,143 @@
+#include <unity.h>
+#include "../src/BurpSerialization/CachedIPv4.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "CachedIPv4.hpp"
+
+namespace CachedIPv4 {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr char fieldName[] = "field";
+    constexpr char validIPv4[] = "10.0.100.1";
+    constexpr uint32_t validUInt32 = ((((((10 * 256) + 0) * 256) + 100) * 256) + 1);
+    constexpr char otherIPv4[] = "192.168.0.1";
+    constexpr uint32_t otherUInt32 = 0xc0a80001;
+    constexpr uint8_t validMsgPack[] = {0xc4, 4, 10, 0, 100, 1};
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                notPresent,
+                wrongType,
+                invalidCharacter,
+                outOfRange,
+                missingByte,
+                excessCharacters
+            };
+
+            BurpSerialization::CachedIPv4::Value ipv4;
+
+            Serialization() :
+                BurpSerialization::Serialization(_ipv4),
+                _ipv4({
+                    ok,
+                    notPresent,
+                    wrongType,
+                    invalidCharacter,
+                    outOfRange,
+                    missingByte,
+                    excessCharacters
+                }, ipv4)
+            {}
+
+        private:
+
+            const BurpSerialization::CachedIPv4 _ipv4;
+
+    };
+
+    Module tests("CachedIPv4", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("with a valid value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = validIPv4;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.ipv4.isNull);
+                    TEST_ASSERT_EQUAL(validUInt32, serialization.ipv4.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("serialize", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should set the value in the JSON document to NULL", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = true;
+                    serialization.ipv4.isNull = true;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(doc[fieldName].isNull());
+                });
+            });
+            d.describe("with a valid value", [](Describe & d) {
+                d.it("should link the text without copying it into the document", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validIPv4, doc.as<const char *>());
+                    TEST_ASSERT_EQUAL(0, doc.memoryUsage());
+                });
+            });
+            d.describe("with the same value again", [](Describe & d) {
+                d.it("should set the same text", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.ipv4.value = validUInt32;
+                    serialization.serialize(doc.to<JsonVariant>());
+                    auto first = doc.as<const char *>();
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_PTR(first, doc.as<const char *>());
+                });
+            });
+            d.describe("with a changed value", [](Describe & d) {
+                d.it("should set the text of the new value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.ipv4.value = validUInt32;
+                    serialization.serialize(doc.to<JsonVariant>());
+                    serialization.ipv4.value = otherUInt32;
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(otherIPv4, doc.as<const char *>());
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"10.0.100.1\"", buffer);
+                });
+            });
+            d.describe("with a value as MessagePack", [](Describe & d) {
+                d.it("should write the address as 4 bytes of bin", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
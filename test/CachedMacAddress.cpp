@@ -0,0 +1,152 @@
+#include <unity.h>
+#include "../src/BurpSerialization/CachedMacAddress.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "CachedMacAddress.hpp"
+
+namespace CachedMacAddress {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr char fieldName[] = "field";
+    constexpr char validMacAddress[] = "12-34-05-78-9a-bc";
+    constexpr char serializedMacAddress[] = "12:34:05:78:9A:BC";
+    constexpr char otherMacAddress[] = "12:34:05:78:9A:BD";
+    constexpr uint8_t validArray[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {
+        0x12,
+        0x34,
+        0x5,
+        0x78,
+        0x9a,
+        0xbc
+    };
+    constexpr uint8_t validMsgPack[] = {0xc4, 6, 0x12, 0x34, 0x05, 0x78, 0x9a, 0xbc};
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                notPresent,
+                wrongType,
+                invalidCharacter,
+                invalidSeparator,
+                outOfRange,
+                missingByte,
+                excessCharacters
+            };
+
+            BurpSerialization::CachedMacAddress::Value macAddress;
+
+            Serialization() :
+                BurpSerialization::Serialization(_macAddress),
+                _macAddress({
+                    ok,
+                    notPresent,
+                    wrongType,
+                    invalidCharacter,
+                    invalidSeparator,
+                    outOfRange,
+                    missingByte,
+                    excessCharacters
+                }, macAddress)
+            {}
+
+        private:
+
+            const BurpSerialization::CachedMacAddress _macAddress;
+
+    };
+
+    Module tests("CachedMacAddress", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("with a valid value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = validMacAddress;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.macAddress.isNull);
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validArray, serialization.macAddress.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("serialize", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should set the value in the JSON document to NULL", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = true;
+                    serialization.macAddress.isNull = true;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(doc[fieldName].isNull());
+                });
+            });
+            d.describe("with a valid value", [](Describe & d) {
+                d.it("should link the text without copying it into the document", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(serializedMacAddress, doc.as<const char *>());
+                    TEST_ASSERT_EQUAL(0, doc.memoryUsage());
+                });
+            });
+            d.describe("with the same value again", [](Describe & d) {
+                d.it("should set the same text", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    serialization.serialize(doc.to<JsonVariant>());
+                    auto first = doc.as<const char *>();
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_PTR(first, doc.as<const char *>());
+                });
+            });
+            d.describe("with a changed value", [](Describe & d) {
+                d.it("should set the text of the new value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    serialization.serialize(doc.to<JsonVariant>());
+                    serialization.macAddress.value[BurpSerialization::MAC_ADDRESS_BYTE_COUNT - 1]++;
+                    auto success = serialization.serialize(doc.to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(otherMacAddress, doc.as<const char *>());
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"12:34:05:78:9A:BC\"", buffer);
+                });
+            });
+            d.describe("with a value as MessagePack", [](Describe & d) {
+                d.it("should write the address as 6 bytes of bin", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
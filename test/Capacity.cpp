@@ -0,0 +1,189 @@
+#include <unity.h>
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/CStrMap.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "Capacity.hpp"
+
+namespace Capacity {
+
+    constexpr size_t bufferSize = 2048;
+    constexpr size_t maxNameLength = 16;
+    constexpr char nameName[] = "name";
+    constexpr char countName[] = "count";
+    constexpr char modeName[] = "mode";
+    constexpr char levelsName[] = "levels";
+    constexpr char addressName[] = "address";
+    constexpr char macName[] = "mac";
+    constexpr char choiceOne[] = "one";
+    constexpr char choiceTwo[] = "two";
+    constexpr char choiceThree[] = "three";
+    constexpr char longestName[] = "sixteen chars!!!";
+    constexpr uint8_t longestMac[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            using Mode = BurpSerialization::CStrMap<uint8_t, 3>;
+            using Object = BurpSerialization::Object<6>;
+
+            static constexpr BurpSerialization::Capacity capacity() {
+                return Object::capacity(
+                    BurpSerialization::constLength(nameName) +
+                    BurpSerialization::constLength(countName) +
+                    BurpSerialization::constLength(modeName) +
+                    BurpSerialization::constLength(levelsName) +
+                    BurpSerialization::constLength(addressName) +
+                    BurpSerialization::constLength(macName),
+                    BurpSerialization::CStr::capacity(maxNameLength),
+                    BurpSerialization::Scalar<int>::capacity(),
+                    Mode::capacity(BurpSerialization::constLength(choiceThree)),
+                    BurpSerialization::PWMLevels::capacity(),
+                    BurpSerialization::IPv4::capacity(),
+                    BurpSerialization::MacAddress::capacity()
+                );
+            }
+
+            struct {
+                bool isNull;
+                const char * name;
+                BurpSerialization::Scalar<int>::Value count;
+                Mode::Value mode;
+                BurpSerialization::PWMLevels::Value levels;
+                BurpSerialization::IPv4::Value address;
+                BurpSerialization::MacAddress::Value mac;
+            } obj;
+
+            Serialization() :
+                BurpSerialization::Serialization(_obj),
+                _name(1, maxNameLength, {0, 1, 2, 3, 4}, obj.name),
+                _count({0, 1, 2}, obj.count),
+                _mode({
+                    Mode::Choice({choiceOne, 1}),
+                    Mode::Choice({choiceTwo, 2}),
+                    Mode::Choice({choiceThree, 3})
+                }, {0, 1, 2, 3}, obj.mode),
+                _levels({0, 1, 2, 3, 4, 5, 6, 7, 8}, obj.levels),
+                _address({0, 1, 2, 3, 4, 5, 6}, obj.address),
+                _mac({0, 1, 2, 3, 4, 5, 6, 7}, obj.mac),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count}),
+                    Object::Entry({modeName, &_mode}),
+                    Object::Entry({levelsName, &_levels}),
+                    Object::Entry({addressName, &_address}),
+                    Object::Entry({macName, &_mac})
+                }, {0, 1, 2}, obj.isNull)
+            {}
+
+            // the longest value of every field
+            void setLongest() {
+                obj.isNull = false;
+                obj.name = longestName;
+                obj.count.isNull = false;
+                obj.count.value = INT32_MIN;
+                obj.mode.isNull = false;
+                obj.mode.value = 3;
+                obj.levels.isNull = false;
+                for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels; index++) {
+                    obj.levels.list[index] = index + 1;
+                }
+                obj.levels.length = BurpSerialization::PWMLevels::maxLevels;
+                obj.address.isNull = false;
+                obj.address.value = UINT32_MAX;
+                obj.mac.isNull = false;
+                memcpy(obj.mac.value, longestMac, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+            }
+
+        private:
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::Scalar<int> _count;
+            const Mode _mode;
+            const BurpSerialization::PWMLevels _levels;
+            const BurpSerialization::IPv4 _address;
+            const BurpSerialization::MacAddress _mac;
+            const Object _obj;
+
+    };
+
+    constexpr BurpSerialization::Capacity capacity = Serialization::capacity();
+
+    Module tests("Capacity", [](Describe & d) {
+        d.describe("of a scalar", [](Describe & d) {
+            d.it("should need nothing beyond its slot", []() {
+                TEST_ASSERT_EQUAL(0, BurpSerialization::Scalar<int>::capacity().document());
+            });
+        });
+        d.describe("of an object", [](Describe & d) {
+            d.it("should add up the slots, keys and entries", []() {
+                constexpr auto object = BurpSerialization::Object<2>::capacity(
+                    3,
+                    BurpSerialization::Scalar<int>::capacity(),
+                    BurpSerialization::CStr::capacity(4)
+                );
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2), object.deserializeInPlace());
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2) + 3 + 2 + JSON_STRING_SIZE(4), object.deserialize());
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2), object.serialize());
+            });
+        });
+        d.describe("of an object with names and choices in flash", [](Describe & d) {
+            d.it("should add the copied names and keys to serialize", []() {
+                using FlashMap = BurpSerialization::CStrMap<int, 2, BurpSerialization::CopiedCodes, const BurpSerialization::FlashString *>;
+                constexpr auto object = BurpSerialization::Object<2, BurpSerialization::CopiedCodes, const BurpSerialization::FlashString *>::capacity(
+                    3,
+                    BurpSerialization::Scalar<int>::capacity(),
+                    FlashMap::capacity(4)
+                );
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2) + 3 + 2 + JSON_STRING_SIZE(4), object.deserialize());
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2) + 3 + 2 + JSON_STRING_SIZE(4), object.serialize());
+            });
+        });
+        d.describe("deserializing the longest values from read only input", [](Describe & d) {
+            d.it("should be enough", []() {
+                Serialization serialization;
+                char json[bufferSize];
+                serialization.setLongest();
+                BurpSerialization::Writer writer(json, bufferSize);
+                TEST_ASSERT_TRUE(serialization.serialize(writer));
+                StaticJsonDocument<capacity.deserialize()> doc;
+                auto error = deserializeJson(doc, static_cast<const char *>(json));
+                TEST_ASSERT_FALSE(error);
+                TEST_ASSERT_EQUAL(0, serialization.deserialize(doc.as<JsonVariant>()));
+            });
+        });
+        d.describe("deserializing the longest values in place", [](Describe & d) {
+            d.it("should be enough", []() {
+                Serialization serialization;
+                char json[bufferSize];
+                serialization.setLongest();
+                BurpSerialization::Writer writer(json, bufferSize);
+                TEST_ASSERT_TRUE(serialization.serialize(writer));
+                StaticJsonDocument<capacity.deserializeInPlace()> doc;
+                auto error = deserializeJson(doc, json);
+                TEST_ASSERT_FALSE(error);
+                TEST_ASSERT_EQUAL(0, serialization.deserialize(doc.as<JsonVariant>()));
+            });
+        });
+        d.describe("serializing the longest values", [](Describe & d) {
+            d.it("should be enough", []() {
+                Serialization serialization;
+                serialization.setLongest();
+                StaticJsonDocument<capacity.serialize()> doc;
+                TEST_ASSERT_TRUE(serialization.serialize(doc.to<JsonVariant>()));
+            });
+        });
+        d.describe("of a document for both directions", [](Describe & d) {
+            d.it("should cover each of them", []() {
+                TEST_ASSERT_TRUE(capacity.document() >= capacity.deserialize());
+                TEST_ASSERT_TRUE(capacity.document() >= capacity.serialize());
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include <unity.h>
+#include "../src/BurpSerialization/Codes.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/Parser.hpp"
+#include "Codes.hpp"
+
+namespace Codes {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr char fieldName[] = "field";
+    constexpr char countName[] = "count";
+    constexpr char addressName[] = "address";
+    constexpr char outOfRangeIPv4[] = "255.256.255.255";
+    constexpr char validIPv4[] = "10.0.100.1";
+    constexpr uint32_t validUInt32 = ((((((10 * 256) + 0) * 256) + 100) * 256) + 1);
+    constexpr char longCStr[] = "too long";
+    constexpr char levelWrongTypeJson[] = "[1,\"two\",3]";
+    constexpr char levelNotPresentJson[] = "[1,null,3]";
+    constexpr char validLevelsJson[] = "[1,2,3]";
+
+    enum : BurpStatus::Status::Code {
+        ok,
+        notPresent,
+        wrongType,
+        invalidCharacter,
+        outOfRange,
+        missingByte,
+        excessCharacters,
+        tooShort,
+        tooLong,
+        levelZero,
+        levelNotIncreasing,
+        levelNotPresent,
+        levelWrongType,
+        invalidSeparator,
+        countNotPresent,
+        countWrongType,
+        addressNotPresent
+    };
+
+    const BurpSerialization::SharedIPv4::StatusCodes ipv4Codes PROGMEM = {
+        ok,
+        addressNotPresent,
+        wrongType,
+        invalidCharacter,
+        outOfRange,
+        missingByte,
+        excessCharacters
+    };
+
+    const BurpSerialization::SharedMacAddress::StatusCodes macAddressCodes PROGMEM = {
+        ok,
+        notPresent,
+        wrongType,
+        invalidCharacter,
+        invalidSeparator,
+        outOfRange,
+        missingByte,
+        excessCharacters
+    };
+
+    const BurpSerialization::SharedCStr::StatusCodes cStrCodes PROGMEM = {
+        ok,
+        notPresent,
+        wrongType,
+        tooShort,
+        tooLong
+    };
+
+    const BurpSerialization::SharedPWMLevels::StatusCodes pwmLevelsCodes PROGMEM = {
+        ok,
+        notPresent,
+        wrongType,
+        tooLong,
+        tooShort,
+        levelZero,
+        levelNotIncreasing,
+        levelNotPresent,
+        levelWrongType
+    };
+
+    using Count = BurpSerialization::Scalar<int, BurpSerialization::SharedCodes>;
+    using Root = BurpSerialization::Object<2, BurpSerialization::SharedCodes>;
+
+    const Count::StatusCodes countCodes PROGMEM = {
+        ok,
+        countNotPresent,
+        countWrongType
+    };
+
+    const Root::StatusCodes rootCodes PROGMEM = {
+        ok,
+        notPresent,
+        wrongType
+    };
+
+    const BurpSerialization::Parser::StatusCodes parserCodes = {0, 100, 101, 102, 103};
+
+    BurpStatus::Status::Code parse(const BurpSerialization::Field & field, const char * json) {
+        char buffer[bufferSize];
+        BurpSerialization::Parser parser(field, buffer, bufferSize, parserCodes);
+        parser.begin();
+        parser.write(json, strlen(json));
+        return parser.end();
+    }
+
+    // a schema where every field reads its codes from a shared table
+    struct Schema {
+
+        Count::Value count;
+        BurpSerialization::SharedIPv4::Value address;
+        bool isNull;
+        const Count countField;
+        const BurpSerialization::SharedIPv4 addressField;
+        const Root root;
+
+        Schema() :
+            countField(&countCodes, count),
+            addressField(&ipv4Codes, address),
+            root({
+                Root::Entry({countName, &countField}),
+                Root::Entry({addressName, &addressField})
+            }, &rootCodes, isNull)
+        {}
+
+    };
+
+    Module tests("Codes", [](Describe & d) {
+        d.describe("SharedCodes", [](Describe & d) {
+            d.describe("with an IPv4", [](Describe & d) {
+                d.describe("with an invalid value", [](Describe & d) {
+                    d.it("should fail with the code from the table", []() {
+                        BurpSerialization::SharedIPv4::Value value;
+                        BurpSerialization::SharedIPv4 field(&ipv4Codes, value);
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = outOfRangeIPv4;
+                        auto code = field.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(value.isNull);
+                        TEST_ASSERT_EQUAL(outOfRange, code);
+                    });
+                });
+                d.describe("with a valid value", [](Describe & d) {
+                    d.it("should have the correct value", []() {
+                        BurpSerialization::SharedIPv4::Value value;
+                        BurpSerialization::SharedIPv4 field(&ipv4Codes, value);
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = validIPv4;
+                        auto code = field.deserialize(doc[fieldName]);
+                        TEST_ASSERT_FALSE(value.isNull);
+                        TEST_ASSERT_EQUAL(validUInt32, value.value);
+                        TEST_ASSERT_EQUAL(ok, code);
+                    });
+                });
+                d.describe("compared with copied codes", [](Describe & d) {
+                    d.it("should be smaller", []() {
+                        TEST_ASSERT_LESS_THAN(sizeof(BurpSerialization::IPv4), sizeof(BurpSerialization::SharedIPv4));
+                    });
+                });
+            });
+            d.describe("with a MacAddress of the wrong type", [](Describe & d) {
+                d.it("should fail with the code from the table", []() {
+                    BurpSerialization::SharedMacAddress::Value value;
+                    BurpSerialization::SharedMacAddress field(&macAddressCodes, value);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = true;
+                    auto code = field.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(value.isNull);
+                    TEST_ASSERT_EQUAL(wrongType, code);
+                });
+            });
+            d.describe("with a CStr that is too long", [](Describe & d) {
+                d.it("should fail with the code from the table", []() {
+                    const char * value;
+                    BurpSerialization::SharedCStr field(1, 4, &cStrCodes, value);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = longCStr;
+                    auto code = field.deserialize(doc[fieldName]);
+                    TEST_ASSERT_NULL(value);
+                    TEST_ASSERT_EQUAL(tooLong, code);
+                });
+            });
+            d.describe("with an Object", [](Describe & d) {
+                d.describe("when sub fields are not present", [](Describe & d) {
+                    d.it("should report the last in entry order", []() {
+                        Schema schema;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName][countName] = 1;
+                        auto code = schema.root.deserialize(doc[fieldName]);
+                        TEST_ASSERT_FALSE(schema.isNull);
+                        TEST_ASSERT_EQUAL(1, schema.count.value);
+                        TEST_ASSERT_EQUAL(addressNotPresent, code);
+                    });
+                });
+                d.describe("with a sub field of the wrong type", [](Describe & d) {
+                    d.it("should pass up its code", []() {
+                        Schema schema;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName][countName] = validIPv4;
+                        doc[fieldName][addressName] = validIPv4;
+                        auto code = schema.root.deserialize(doc[fieldName]);
+                        TEST_ASSERT_EQUAL(countWrongType, code);
+                    });
+                });
+            });
+            d.describe("with PWMLevels through Parser", [](Describe & d) {
+                d.describe("with a level of the wrong type", [](Describe & d) {
+                    d.it("should fail with the level code from the table", []() {
+                        BurpSerialization::SharedPWMLevels::Value value;
+                        BurpSerialization::SharedPWMLevels field(&pwmLevelsCodes, value);
+                        auto code = parse(field, levelWrongTypeJson);
+                        TEST_ASSERT_TRUE(value.isNull);
+                        TEST_ASSERT_EQUAL(levelWrongType, code);
+                    });
+                });
+                d.describe("with a level that is null", [](Describe & d) {
+                    d.it("should fail with the level code from the table", []() {
+                        BurpSerialization::SharedPWMLevels::Value value;
+                        BurpSerialization::SharedPWMLevels field(&pwmLevelsCodes, value);
+                        auto code = parse(field, levelNotPresentJson);
+                        TEST_ASSERT_TRUE(value.isNull);
+                        TEST_ASSERT_EQUAL(levelNotPresent, code);
+                    });
+                });
+                d.describe("with valid levels", [](Describe & d) {
+                    d.it("should have the correct values", []() {
+                        BurpSerialization::SharedPWMLevels::Value value;
+                        BurpSerialization::SharedPWMLevels field(&pwmLevelsCodes, value);
+                        auto code = parse(field, validLevelsJson);
+                        TEST_ASSERT_FALSE(value.isNull);
+                        TEST_ASSERT_EQUAL(3, value.length);
+                        TEST_ASSERT_EQUAL(2, value.list[1]);
+                        TEST_ASSERT_EQUAL(ok, code);
+                    });
+                });
+            });
+        });
+        d.describe("CopiedCodes", [](Describe & d) {
+            d.describe("with PWMLevels through Parser", [](Describe & d) {
+                d.describe("with a level of the wrong type", [](Describe & d) {
+                    d.it("should fail with the level code", []() {
+                        BurpSerialization::PWMLevels::Value value;
+                        BurpSerialization::PWMLevels field({
+                            ok,
+                            notPresent,
+                            wrongType,
+                            tooLong,
+                            tooShort,
+                            levelZero,
+                            levelNotIncreasing,
+                            levelNotPresent,
+                            levelWrongType
+                        }, value);
+                        auto code = parse(field, levelWrongTypeJson);
+                        TEST_ASSERT_TRUE(value.isNull);
+                        TEST_ASSERT_EQUAL(levelWrongType, code);
+                    });
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace Codes {
+    
+  extern Module tests;
+
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <unity.h>
+#include "../src/BurpSerialization/Delta.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "Delta.hpp"
+
+namespace Delta {
+
+    constexpr size_t docSize = 256;
+    constexpr size_t bufferSize = 128;
+    constexpr size_t slotCount = 5;
+    // a presence byte a slot and the three ints
+    constexpr size_t byteCount = slotCount + 3 * sizeof(int);
+    // room for the root, one and nested but not two and three
+    constexpr size_t fewBytes = 3 + sizeof(int);
+    constexpr char fullJson[] = "{\"one\":1,\"nested\":{\"two\":2,\"three\":3}}";
+
+    using Int = BurpSerialization::Scalar<int>;
+    using Pair = BurpSerialization::Object<2>;
+
+    // {"one": int, "nested": {"two": int, "three": int}}
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            struct {
+                bool isNull = false;
+                Int::Value one;
+                struct {
+                    bool isNull = false;
+                    Int::Value two;
+                    Int::Value three;
+                } nested;
+            } obj;
+
+            Serialization() :
+                BurpSerialization::Serialization(_obj),
+                _one({0, 0, 1}, obj.one),
+                _two({0, 0, 1}, obj.nested.two),
+                _three({0, 0, 1}, obj.nested.three),
+                _nested({
+                    Pair::Entry({"two", &_two}),
+                    Pair::Entry({"three", &_three})
+                }, {0, 0, 1}, obj.nested.isNull),
+                _obj({
+                    Pair::Entry({"one", &_one}),
+                    Pair::Entry({"nested", &_nested})
+                }, {0, 0, 1}, obj.isNull)
+            {
+                obj.one.value = 1;
+                obj.nested.two.value = 2;
+                obj.nested.three.value = 3;
+            }
+
+            // the delta as JSON text, empty when it failed
+            const char * delta(BurpSerialization::Delta & delta) {
+                StaticJsonDocument<docSize> doc;
+                _buffer[0] = 0;
+                if (serializeDelta(doc.to<JsonVariant>(), delta)) serializeJson(doc, _buffer, bufferSize);
+                return _buffer;
+            }
+
+        private:
+
+            const Int _one;
+            const Int _two;
+            const Int _three;
+            const Pair _nested;
+            const Pair _obj;
+            char _buffer[bufferSize];
+
+    };
+
+    using Slots = BurpSerialization::StaticDelta<slotCount, byteCount>;
+
+    Module tests("Delta", [](Describe & d) {
+        d.describe("the first delta", [](Describe & d) {
+            d.it("should have everything", []() {
+                Serialization serialization;
+                Slots delta;
+                TEST_ASSERT_EQUAL_STRING(fullJson, serialization.delta(delta));
+                TEST_ASSERT_TRUE(delta.changed());
+            });
+        });
+        d.describe("with nothing changed", [](Describe & d) {
+            d.it("should be null", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                TEST_ASSERT_EQUAL_STRING("null", serialization.delta(delta));
+                TEST_ASSERT_FALSE(delta.changed());
+            });
+        });
+        d.describe("with a top level value changed", [](Describe & d) {
+            d.it("should have only that value", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.one.value = 10;
+                TEST_ASSERT_EQUAL_STRING("{\"one\":10}", serialization.delta(delta));
+                TEST_ASSERT_EQUAL_STRING("null", serialization.delta(delta));
+            });
+        });
+        d.describe("with a nested value changed", [](Describe & d) {
+            d.it("should have only the path to it", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.nested.three.value = 30;
+                TEST_ASSERT_EQUAL_STRING("{\"nested\":{\"three\":30}}", serialization.delta(delta));
+            });
+        });
+        d.describe("with several changes between deltas", [](Describe & d) {
+            d.it("should have them all in one", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.one.value = 10;
+                serialization.obj.nested.two.value = 20;
+                serialization.obj.nested.two.value = 21;
+                TEST_ASSERT_EQUAL_STRING("{\"one\":10,\"nested\":{\"two\":21}}", serialization.delta(delta));
+            });
+        });
+        d.describe("with a value changed and changed back", [](Describe & d) {
+            d.it("should be null", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.one.value = 10;
+                serialization.obj.one.value = 1;
+                TEST_ASSERT_EQUAL_STRING("null", serialization.delta(delta));
+            });
+        });
+        d.describe("with a value set to null", [](Describe & d) {
+            d.it("should have null for it, to remove it", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.nested.two.isNull = true;
+                TEST_ASSERT_EQUAL_STRING("{\"nested\":{\"two\":null}}", serialization.delta(delta));
+            });
+        });
+        d.describe("with a nested object", [](Describe & d) {
+            d.describe("set to null", [](Describe & d) {
+                d.it("should have null for it", []() {
+                    Serialization serialization;
+                    Slots delta;
+                    serialization.delta(delta);
+                    serialization.obj.nested.isNull = true;
+                    TEST_ASSERT_EQUAL_STRING("{\"nested\":null}", serialization.delta(delta));
+                });
+            });
+            d.describe("set back from null", [](Describe & d) {
+                d.it("should have the whole object", []() {
+                    Serialization serialization;
+                    Slots delta;
+                    serialization.obj.nested.isNull = true;
+                    serialization.delta(delta);
+                    serialization.obj.nested.isNull = false;
+                    TEST_ASSERT_EQUAL_STRING("{\"nested\":{\"two\":2,\"three\":3}}", serialization.delta(delta));
+                });
+            });
+        });
+        d.describe("after reset", [](Describe & d) {
+            d.it("should have everything again", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                delta.reset();
+                TEST_ASSERT_EQUAL_STRING(fullJson, serialization.delta(delta));
+            });
+        });
+        d.describe("with too few slots", [](Describe & d) {
+            d.it("should fail", []() {
+                Serialization serialization;
+                BurpSerialization::StaticDelta<slotCount - 1, byteCount> delta;
+                TEST_ASSERT_EQUAL_STRING("", serialization.delta(delta));
+            });
+        });
+        d.describe("with too few bytes", [](Describe & d) {
+            d.it("should always have the values that do not fit", []() {
+                Serialization serialization;
+                BurpSerialization::StaticDelta<slotCount, fewBytes> delta;
+                serialization.delta(delta);
+                TEST_ASSERT_EQUAL_STRING("{\"nested\":{\"two\":2,\"three\":3}}", serialization.delta(delta));
+                serialization.obj.one.value = 10;
+                TEST_ASSERT_EQUAL_STRING("{\"one\":10,\"nested\":{\"two\":2,\"three\":3}}", serialization.delta(delta));
+            });
+        });
+        d.describe("when serialize fails", [](Describe & d) {
+            d.it("should not commit, so the changes come again", []() {
+                Serialization serialization;
+                Slots delta;
+                serialization.delta(delta);
+                serialization.obj.one.value = 10;
+                StaticJsonDocument<JSON_OBJECT_SIZE(0)> small;
+                small.to<JsonObject>();
+                TEST_ASSERT_FALSE(serialization.serializeDelta(small.to<JsonVariant>(), delta));
+                TEST_ASSERT_EQUAL_STRING("{\"one\":10}", serialization.delta(delta));
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -6,14 +6,21 @@
 namespace IPv4 {
 
     constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 4;
     constexpr char fieldName[] = "field";
-    constexpr int wrongTypeIPv4 = 100;
+    constexpr bool wrongTypeIPv4 = true;
     constexpr char invalidCharacterIPv4[] = "100hello";
     constexpr char outOfRangeIPv4[] = "255.256.255.255";
     constexpr char missingByteIPv4[] = "255..255.255";
     constexpr char excessCharactersIPv4[] = "255.255.255.255.255";
     constexpr char validIPv4[] = "10.0.100.1";
+    constexpr char paddedIPv4[] = "010.000.100.001";
+    constexpr char longestIPv4[] = "255.255.255.255";
     constexpr uint32_t validUInt32 = ((((((10 * 256) + 0) * 256) + 100) * 256) + 1);
+    constexpr long long outOfRangeInteger = 0x100000000ll;
+    constexpr uint8_t validMsgPack[] = {0xc4, 4, 10, 0, 100, 1};
+    constexpr uint8_t validNetwork[] = {10, 0, 100, 1};
 
     class Serialization : public BurpSerialization::Serialization {
 
@@ -31,7 +38,7 @@ namespace IPv4 {
 
             BurpSerialization::IPv4::Value ipv4;
 
-            Serialization() :
+            Serialization(const BurpSerialization::IPv4Form form = BurpSerialization::IPv4Form::text) :
                 BurpSerialization::Serialization(_ipv4),
                 _ipv4({
                     ok,
@@ -41,7 +48,7 @@ namespace IPv4 {
                     outOfRange,
                     missingByte,
                     excessCharacters
-                }, ipv4)
+                }, ipv4, form)
             {}
 
         private:
@@ -122,6 +129,51 @@ namespace IPv4 {
                     TEST_ASSERT_EQUAL(Serialization::ok, code);
                 });
             });
+            d.describe("with leading zeros", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = paddedIPv4;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.ipv4.isNull);
+                    TEST_ASSERT_EQUAL(validUInt32, serialization.ipv4.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with the longest value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = longestIPv4;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.ipv4.isNull);
+                    TEST_ASSERT_EQUAL(0xffffffff, serialization.ipv4.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with an integer", [](Describe & d) {
+                d.describe("with a valid value", [](Describe & d) {
+                    d.it("should not fail and have the correct value", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = validUInt32;
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_FALSE(serialization.ipv4.isNull);
+                        TEST_ASSERT_EQUAL(validUInt32, serialization.ipv4.value);
+                        TEST_ASSERT_EQUAL(Serialization::ok, code);
+                    });
+                });
+                d.describe("with an out of range value", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = outOfRangeInteger;
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.ipv4.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::outOfRange, code);
+                    });
+                });
+            });
         });
 
         d.describe("serialize", [](Describe & d) {
@@ -155,6 +207,82 @@ namespace IPv4 {
                     TEST_ASSERT_EQUAL_STRING(validIPv4, doc[fieldName]);
                 });
             });
+            d.describe("with the integer form", [](Describe & d) {
+                d.it("should set the integer in the JSON document", []() {
+                    Serialization serialization(BurpSerialization::IPv4Form::integer);
+                    StaticJsonDocument<docSize> doc;
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(validUInt32, doc[fieldName].as<uint32_t>());
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.ipv4.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"10.0.100.1\"", buffer);
+                });
+            });
+            d.describe("with a value as MessagePack", [](Describe & d) {
+                d.it("should write the address as 4 bytes of bin", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+            d.describe("with the integer form", [](Describe & d) {
+                d.it("should write the integer", []() {
+                    Serialization serialization(BurpSerialization::IPv4Form::integer);
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.ipv4.value = validUInt32;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("167797761", buffer);
+                });
+            });
+        });
+
+        d.describe("network byte order", [](Describe & d) {
+            d.it("should hold the most significant byte first in memory and convert back", []() {
+                auto network = BurpSerialization::ipv4ToNetwork(validUInt32);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(validNetwork, reinterpret_cast<const uint8_t *>(&network), sizeof(validNetwork));
+                TEST_ASSERT_EQUAL(validUInt32, BurpSerialization::ipv4FromNetwork(network));
+            });
         });
     });
 
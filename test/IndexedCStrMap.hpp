@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace IndexedCStrMap {
+    
+  extern Module tests;
+
+}
@@ -0,0 +1,274 @@
+#include <unity.h>
+#include <string.h>
+#ifdef BURP_NATIVE
+#include <vector>
+#endif
+#include "../src/BurpSerialization/JsonLines.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "JsonLines.hpp"
+
+namespace JsonLines {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t smallDocSize = 16;
+    constexpr size_t bufferSize = 256;
+    constexpr size_t maxRecords = 8;
+    constexpr char nameName[] = "name";
+    constexpr char countName[] = "count";
+    constexpr char validLines[] = "{\"name\": \"one\", \"count\": 1}\n{\"name\": \"two\", \"count\": 2}\n{\"name\": \"three\", \"count\": 3}\n";
+    constexpr char emptyLines[] = "\n{\"name\": \"one\", \"count\": 1}\r\n\r\n\n{\"name\": \"two\", \"count\": 2}";
+    constexpr char invalidLine[] = "{\"name\": \"one\", \"count\": 1}\n{\"name\": \"two\",\n{\"name\": \"three\", \"count\": 3}\n";
+    constexpr char failingRecord[] = "{\"name\": \"one\", \"count\": 1}\n{\"name\": \"two\", \"count\": \"two\"}\n";
+#ifdef BURP_NATIVE
+    constexpr size_t runCount = 3;
+    constexpr char manyLines[] =
+        "{\"name\": \"a\", \"count\": 0}\n{\"name\": \"b\", \"count\": 1}\n{\"name\": \"c\", \"count\": 2}\n"
+        "{\"name\": \"d\", \"count\": 3}\n{\"name\": \"e\", \"count\": 4}\n{\"name\": \"f\", \"count\": 5}\n"
+        "{\"name\": \"g\", \"count\": 6}\n";
+    constexpr size_t manyLinesCount = 7;
+#endif
+
+    using Int = BurpSerialization::Scalar<int>;
+
+    struct Record {
+        bool isNull;
+        const char * name;
+        Int::Value count;
+    };
+
+    // {"name": string, "count": int}
+    class Decoder : public BurpSerialization::Serialization {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                invalidInput,
+                noMemory,
+                notPresent,
+                wrongType,
+                nameNotPresent,
+                nameWrongType,
+                nameTooShort,
+                nameTooLong,
+                countNotPresent,
+                countWrongType
+            };
+
+            Record scratch;
+            BurpSerialization::JsonLines<Record> lines;
+
+            Decoder(JsonDocument & doc) :
+                BurpSerialization::Serialization(_obj),
+                lines(*this, scratch, doc, {
+                    ok,
+                    invalidInput,
+                    noMemory
+                }),
+                _name(1, 16, {
+                    ok,
+                    nameNotPresent,
+                    nameWrongType,
+                    nameTooShort,
+                    nameTooLong
+                }, scratch.name),
+                _count({
+                    ok,
+                    countNotPresent,
+                    countWrongType
+                }, scratch.count),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count})
+                }, {
+                    ok,
+                    notPresent,
+                    wrongType
+                }, scratch.isNull)
+            {}
+
+        private:
+
+            using Object = BurpSerialization::Object<2>;
+
+            const BurpSerialization::CStr _name;
+            const Int _count;
+            const Object _obj;
+
+    };
+
+#ifdef BURP_NATIVE
+    using Workers = BurpSerialization::JsonLinesWorkers<Record>;
+#endif
+
+    size_t decode(const char * text, Record * records, BurpStatus::Status::Code * codes, char * buffer, size_t size = docSize) {
+        DynamicJsonDocument doc(size);
+        Decoder decoder(doc);
+        strcpy(buffer, text);
+        return decoder.lines.decode(buffer, strlen(buffer), records, codes, maxRecords);
+    }
+
+    Module tests("JsonLines", [](Describe & d) {
+        d.describe("decode", [](Describe & d) {
+            d.describe("with valid lines", [](Describe & d) {
+                d.it("should decode every record in order with strings left in the buffer", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    auto count = decode(validLines, records, codes, buffer);
+                    TEST_ASSERT_EQUAL(3, count);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[0]);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[1]);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[2]);
+                    TEST_ASSERT_EQUAL_STRING("one", records[0].name);
+                    TEST_ASSERT_EQUAL_STRING("two", records[1].name);
+                    TEST_ASSERT_EQUAL_STRING("three", records[2].name);
+                    TEST_ASSERT_EQUAL(3, records[2].count.value);
+                    TEST_ASSERT_TRUE(records[2].name >= buffer && records[2].name < buffer + bufferSize);
+                });
+            });
+            d.describe("with empty lines and CRLF line endings", [](Describe & d) {
+                d.it("should skip the empty lines", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    auto count = decode(emptyLines, records, codes, buffer);
+                    TEST_ASSERT_EQUAL(2, count);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[0]);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[1]);
+                    TEST_ASSERT_EQUAL_STRING("one", records[0].name);
+                    TEST_ASSERT_EQUAL_STRING("two", records[1].name);
+                });
+            });
+            d.describe("with a line that is not JSON", [](Describe & d) {
+                d.it("should fail that record, leave it not present and decode the rest", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    auto count = decode(invalidLine, records, codes, buffer);
+                    TEST_ASSERT_EQUAL(3, count);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[0]);
+                    TEST_ASSERT_EQUAL(Decoder::invalidInput, codes[1]);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[2]);
+                    TEST_ASSERT_TRUE(records[1].isNull);
+                    TEST_ASSERT_NULL(records[1].name);
+                    TEST_ASSERT_EQUAL(0, records[1].count.value);
+                    TEST_ASSERT_EQUAL_STRING("three", records[2].name);
+                });
+            });
+            d.describe("with a record that fails the schema", [](Describe & d) {
+                d.it("should give the field code for that record", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    auto count = decode(failingRecord, records, codes, buffer);
+                    TEST_ASSERT_EQUAL(2, count);
+                    TEST_ASSERT_EQUAL(Decoder::ok, codes[0]);
+                    TEST_ASSERT_EQUAL(Decoder::countWrongType, codes[1]);
+                    TEST_ASSERT_TRUE(records[1].count.isNull);
+                });
+            });
+            d.describe("with a document that is too small", [](Describe & d) {
+                d.it("should fail each record with no memory", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    auto count = decode(validLines, records, codes, buffer, smallDocSize);
+                    TEST_ASSERT_EQUAL(3, count);
+                    TEST_ASSERT_EQUAL(Decoder::noMemory, codes[0]);
+                    TEST_ASSERT_EQUAL(Decoder::noMemory, codes[2]);
+                });
+            });
+            d.describe("with more records than the capacity", [](Describe & d) {
+                d.it("should stop at the capacity", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    DynamicJsonDocument doc(docSize);
+                    Decoder decoder(doc);
+                    strcpy(buffer, validLines);
+                    auto count = decoder.lines.decode(buffer, strlen(buffer), records, codes, 2);
+                    TEST_ASSERT_EQUAL(2, count);
+                    TEST_ASSERT_EQUAL_STRING("two", records[1].name);
+                });
+            });
+        });
+
+        d.describe("count", [](Describe & d) {
+            d.it("should count the lines that are not empty", []() {
+                TEST_ASSERT_EQUAL(3, BurpSerialization::JsonLines<Record>::count(validLines, strlen(validLines)));
+                TEST_ASSERT_EQUAL(2, BurpSerialization::JsonLines<Record>::count(emptyLines, strlen(emptyLines)));
+            });
+        });
+
+#ifdef BURP_NATIVE
+        d.describe("JsonLinesWorkers", [](Describe & d) {
+            d.describe("with a decoder per run", [](Describe & d) {
+                d.it("should decode every record in input order", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    DynamicJsonDocument doc0(docSize);
+                    DynamicJsonDocument doc1(docSize);
+                    DynamicJsonDocument doc2(docSize);
+                    Decoder decoder0(doc0);
+                    Decoder decoder1(doc1);
+                    Decoder decoder2(doc2);
+                    Workers::Decoders decoders = {&decoder0.lines, &decoder1.lines, &decoder2.lines};
+                    TEST_ASSERT_EQUAL(runCount, decoders.size());
+                    Workers workers(decoders);
+                    strcpy(buffer, manyLines);
+                    auto count = workers.decode(buffer, strlen(buffer), records, codes, maxRecords);
+                    TEST_ASSERT_EQUAL(manyLinesCount, count);
+                    for (size_t index = 0; index < manyLinesCount; index++) {
+                        TEST_ASSERT_EQUAL(Decoder::ok, codes[index]);
+                        TEST_ASSERT_EQUAL(index, records[index].count.value);
+                        TEST_ASSERT_EQUAL('a' + index, records[index].name[0]);
+                    }
+                });
+            });
+            d.describe("with several batches", [](Describe & d) {
+                d.it("should decode each on the same workers", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    DynamicJsonDocument doc0(docSize);
+                    DynamicJsonDocument doc1(docSize);
+                    Decoder decoder0(doc0);
+                    Decoder decoder1(doc1);
+                    Workers workers({&decoder0.lines, &decoder1.lines});
+                    strcpy(buffer, manyLines);
+                    TEST_ASSERT_EQUAL(manyLinesCount, workers.decode(buffer, strlen(buffer), records, codes, maxRecords));
+                    strcpy(buffer, validLines);
+                    auto count = workers.decode(buffer, strlen(buffer), records, codes, maxRecords);
+                    TEST_ASSERT_EQUAL(3, count);
+                    for (size_t index = 0; index < count; index++) {
+                        TEST_ASSERT_EQUAL(Decoder::ok, codes[index]);
+                    }
+                    TEST_ASSERT_EQUAL_STRING("one", records[0].name);
+                    TEST_ASSERT_EQUAL_STRING("three", records[2].name);
+                });
+            });
+            d.describe("with more records than the capacity", [](Describe & d) {
+                d.it("should stop at the capacity", []() {
+                    char buffer[bufferSize];
+                    Record records[maxRecords];
+                    BurpStatus::Status::Code codes[maxRecords];
+                    DynamicJsonDocument doc0(docSize);
+                    DynamicJsonDocument doc1(docSize);
+                    Decoder decoder0(doc0);
+                    Decoder decoder1(doc1);
+                    Workers workers({&decoder0.lines, &decoder1.lines});
+                    strcpy(buffer, manyLines);
+                    auto count = workers.decode(buffer, strlen(buffer), records, codes, 3);
+                    TEST_ASSERT_EQUAL(3, count);
+                    TEST_ASSERT_EQUAL(2, records[2].count.value);
+                });
+            });
+        });
+#endif
+    });
+
+}
\ No newline at end of file
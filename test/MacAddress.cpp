@@ -5,9 +5,11 @@
 
 namespace MacAddress {
 
-    constexpr size_t docSize = 128;
+    constexpr size_t docSize = 256;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 4;
     constexpr char fieldName[] = "field";
-    constexpr int wrongTypeMacAddress = 100;
+    constexpr bool wrongTypeMacAddress = true;
     constexpr char invalidCharacterMacAddress[] = "10hello";
     constexpr char invalidSeparatorMacAddress[] = "10:ed-23";
     constexpr char outOfRangeMacAddress[] = "12:34:45a:67:89:ab";
@@ -15,6 +17,8 @@ namespace MacAddress {
     constexpr char excessCharactersMacAddress[] = "12:34:56:78:9a:bc:de";
     constexpr char validMacAddressHyphen[] = "12-34-5-78-9A-bC";
     constexpr char validMacAddressColon[] = "12:34:5:78:9A:bC";
+    constexpr char canonicalInvalidSeparatorMacAddress[] = "12:34:05-78:9A:BC";
+    constexpr char canonicalMacAddress[] = "12-34-05-78-9a-bc";
     constexpr char serializedMacAddress[] = "12:34:05:78:9A:BC";
     constexpr uint8_t validArray[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {
         0x12,
@@ -24,6 +28,9 @@ namespace MacAddress {
         0x9a,
         0xbc
     };
+    constexpr uint8_t validMsgPack[] = {0xc4, 6, 0x12, 0x34, 0x05, 0x78, 0x9a, 0xbc};
+    constexpr uint64_t validInteger = 0x123405789abcull;
+    constexpr uint64_t outOfRangeInteger = 0x1000000000000ull;
 
     class Serialization : public BurpSerialization::Serialization {
 
@@ -42,7 +49,7 @@ namespace MacAddress {
 
             BurpSerialization::MacAddress::Value macAddress;
 
-            Serialization() :
+            Serialization(const BurpSerialization::MacAddressForm form = BurpSerialization::MacAddressForm::text) :
                 BurpSerialization::Serialization(_macAddress),
                 _macAddress({
                     ok,
@@ -53,7 +60,7 @@ namespace MacAddress {
                     outOfRange,
                     missingByte,
                     excessCharacters
-                }, macAddress)
+                }, macAddress, form)
             {}
 
         private:
@@ -155,6 +162,121 @@ namespace MacAddress {
                     TEST_ASSERT_EQUAL(Serialization::ok, code);
                 });
             });
+            d.describe("with a canonical value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = canonicalMacAddress;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.macAddress.isNull);
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validArray, serialization.macAddress.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with a canonical length value and an inconsistent separator", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = canonicalInvalidSeparatorMacAddress;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::invalidSeparator, code);
+                });
+            });
+            d.describe("with an array of bytes", [](Describe & d) {
+                d.describe("with a valid value", [](Describe & d) {
+                    d.it("should not fail and have the correct value", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        auto bytes = doc[fieldName].to<JsonArray>();
+                        for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT; index++) {
+                            bytes.add(validArray[index]);
+                        }
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_FALSE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL_UINT8_ARRAY(validArray, serialization.macAddress.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                        TEST_ASSERT_EQUAL(Serialization::ok, code);
+                    });
+                });
+                d.describe("with too few bytes", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        auto bytes = doc[fieldName].to<JsonArray>();
+                        for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT - 1; index++) {
+                            bytes.add(validArray[index]);
+                        }
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::missingByte, code);
+                    });
+                });
+                d.describe("with too many bytes", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        auto bytes = doc[fieldName].to<JsonArray>();
+                        for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT; index++) {
+                            bytes.add(validArray[index]);
+                        }
+                        bytes.add(0);
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::excessCharacters, code);
+                    });
+                });
+                d.describe("with an out of range byte", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        auto bytes = doc[fieldName].to<JsonArray>();
+                        for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT - 1; index++) {
+                            bytes.add(validArray[index]);
+                        }
+                        bytes.add(256);
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::outOfRange, code);
+                    });
+                });
+                d.describe("with a byte of the wrong type", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        auto bytes = doc[fieldName].to<JsonArray>();
+                        for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT - 1; index++) {
+                            bytes.add(validArray[index]);
+                        }
+                        bytes.add("bc");
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::wrongType, code);
+                    });
+                });
+            });
+            d.describe("with an integer", [](Describe & d) {
+                d.describe("with a valid value", [](Describe & d) {
+                    d.it("should not fail and have the correct value", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = validInteger;
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_FALSE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL_UINT8_ARRAY(validArray, serialization.macAddress.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                        TEST_ASSERT_EQUAL(Serialization::ok, code);
+                    });
+                });
+                d.describe("with an out of range value", [](Describe & d) {
+                    d.it("should fail and not be present", []() {
+                        Serialization serialization;
+                        StaticJsonDocument<docSize> doc;
+                        doc[fieldName] = outOfRangeInteger;
+                        auto code = serialization.deserialize(doc[fieldName]);
+                        TEST_ASSERT_TRUE(serialization.macAddress.isNull);
+                        TEST_ASSERT_EQUAL(Serialization::outOfRange, code);
+                    });
+                });
+            });
         });
 
         d.describe("serialize", [](Describe & d) {
@@ -188,6 +310,119 @@ namespace MacAddress {
                     TEST_ASSERT_EQUAL_STRING(serializedMacAddress, doc[fieldName]);
                 });
             });
+            d.describe("with the bytes form", [](Describe & d) {
+                d.it("should set an array of the bytes in the JSON document", []() {
+                    Serialization serialization(BurpSerialization::MacAddressForm::bytes);
+                    StaticJsonDocument<docSize> doc;
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(BurpSerialization::MAC_ADDRESS_BYTE_COUNT, doc[fieldName].size());
+                    for (size_t index = 0; index < BurpSerialization::MAC_ADDRESS_BYTE_COUNT; index++) {
+                        TEST_ASSERT_EQUAL(validArray[index], doc[fieldName][index].as<uint8_t>());
+                    }
+                });
+            });
+            d.describe("with the integer form", [](Describe & d) {
+                d.it("should set the integer in the JSON document", []() {
+                    Serialization serialization(BurpSerialization::MacAddressForm::integer);
+                    StaticJsonDocument<docSize> doc;
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(validInteger == doc[fieldName].as<uint64_t>());
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.macAddress.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"12:34:05:78:9A:BC\"", buffer);
+                });
+            });
+            d.describe("with a value as MessagePack", [](Describe & d) {
+                d.it("should write the address as 6 bytes of bin", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+            d.describe("with the bytes form", [](Describe & d) {
+                d.it("should write an array of the bytes", []() {
+                    Serialization serialization(BurpSerialization::MacAddressForm::bytes);
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("[18,52,5,120,154,188]", buffer);
+                });
+            });
+            d.describe("with the bytes form as MessagePack", [](Describe & d) {
+                d.it("should write the address as 6 bytes of bin", []() {
+                    Serialization serialization(BurpSerialization::MacAddressForm::bytes);
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+            d.describe("with the integer form", [](Describe & d) {
+                d.it("should write the integer", []() {
+                    Serialization serialization(BurpSerialization::MacAddressForm::integer);
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    memcpy(serialization.macAddress.value, validArray, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("20014639389372", buffer);
+                });
+            });
+        });
+
+        d.describe("integer conversion", [](Describe & d) {
+            d.it("should put the first byte most significant and convert back", []() {
+                TEST_ASSERT_TRUE(validInteger == BurpSerialization::macAddressToInteger(validArray));
+                uint8_t bytes[BurpSerialization::MAC_ADDRESS_BYTE_COUNT];
+                BurpSerialization::macAddressFromInteger(validInteger, bytes);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(validArray, bytes, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+            });
         });
     });
 
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <type_traits>
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "../src/BurpSerialization/MemoryAccounting.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "MemoryAccounting.hpp"
+
+namespace MemoryAccounting {
+
+    using Accounting = BurpSerialization::MemoryAccounting;
+
+#ifdef BURP_SERIALIZATION_ACCOUNTING
+
+    constexpr size_t docSize = 1024;
+    constexpr char networkName[] = "network";
+    constexpr char ipName[] = "ip";
+    constexpr char hostName[] = "host";
+    constexpr char levelName[] = "level";
+    constexpr char rootPath[] = "";
+    constexpr char networkPath[] = "network";
+    constexpr char ipPath[] = "network.ip";
+    constexpr char hostPath[] = "network.host";
+    constexpr char validIP[] = "192.168.100.200";
+    constexpr char validHost[] = "device";
+    constexpr char json[] = "{\"network\":{\"ip\":\"192.168.100.200\",\"host\":\"device\"},\"level\":5}";
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            using Network = BurpSerialization::Object<2>;
+            using Root = BurpSerialization::Object<2>;
+
+            struct {
+                bool isNull;
+                struct {
+                    bool isNull;
+                    BurpSerialization::IPv4::Value ip;
+                    const char * host;
+                } network;
+                BurpSerialization::Scalar<uint8_t>::Value level;
+            } root;
+
+            Serialization() :
+                BurpSerialization::Serialization(_root),
+                _ip({0, 1, 2, 3, 4, 5, 6}, root.network.ip),
+                _host(1, 32, {0, 1, 2, 3, 4}, root.network.host),
+                _network({
+                    Network::Entry({ipName, &_ip}),
+                    Network::Entry({hostName, &_host})
+                }, {0, 1, 2}, root.network.isNull),
+                _level({0, 1, 2}, root.level),
+                _root({
+                    Root::Entry({networkName, &_network}),
+                    Root::Entry({levelName, &_level})
+                }, {0, 1, 2}, root.isNull)
+            {}
+
+        private:
+
+            const BurpSerialization::IPv4 _ip;
+            const BurpSerialization::CStr _host;
+            const Network _network;
+            const BurpSerialization::Scalar<uint8_t> _level;
+            const Root _root;
+
+    };
+
+    Module tests("MemoryAccounting", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("from read only input", [](Describe & d) {
+                d.it("should record each path with its subtree and copied strings", []() {
+                    Serialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    deserializeJson(doc, json);
+                    Accounting::reset();
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL(5, Accounting::count());
+                    TEST_ASSERT_EQUAL(doc.memoryUsage(), Accounting::find(rootPath)->deserialized.bytes);
+                    auto network = Accounting::find(networkPath);
+                    TEST_ASSERT_EQUAL(doc[networkName].memoryUsage(), network->deserialized.bytes);
+                    TEST_ASSERT_EQUAL(
+                        JSON_STRING_SIZE(strlen(ipName)) + JSON_STRING_SIZE(strlen(validIP)) +
+                        JSON_STRING_SIZE(strlen(hostName)) + JSON_STRING_SIZE(strlen(validHost)),
+                        network->deserialized.strings
+                    );
+                    TEST_ASSERT_EQUAL(JSON_STRING_SIZE(strlen(validIP)), Accounting::find(ipPath)->deserialized.bytes);
+                    TEST_ASSERT_EQUAL(JSON_STRING_SIZE(strlen(validIP)), Accounting::find(ipPath)->deserialized.strings);
+                });
+            });
+            d.describe("in place", [](Describe & d) {
+                d.it("should record no copied strings", []() {
+                    Serialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    char buffer[sizeof(json)];
+                    memcpy(buffer, json, sizeof(json));
+                    deserializeJson(doc, buffer);
+                    Accounting::reset();
+                    serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL(0, Accounting::find(rootPath)->deserialized.strings);
+                    TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2), Accounting::find(networkPath)->deserialized.bytes);
+                });
+            });
+        });
+        d.describe("serialize", [](Describe & d) {
+            d.it("should record what each path added, strings that were copied included", []() {
+                Serialization serialization;
+                DynamicJsonDocument doc(docSize);
+                deserializeJson(doc, json);
+                serialization.deserialize(doc.as<JsonVariant>());
+                DynamicJsonDocument out(docSize);
+                Accounting::reset();
+                serialization.serialize(out.to<JsonVariant>());
+                TEST_ASSERT_EQUAL(out.memoryUsage(), Accounting::find(rootPath)->serialized.bytes);
+                // IPv4 writes a formatted copy, CStr links to the value
+                TEST_ASSERT_EQUAL(JSON_STRING_SIZE(strlen(validIP)), Accounting::find(ipPath)->serialized.strings);
+                TEST_ASSERT_EQUAL(0, Accounting::find(hostPath)->serialized.bytes);
+                TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(strlen(validIP)), Accounting::find(networkPath)->serialized.bytes);
+            });
+        });
+        d.describe("high water", [](Describe & d) {
+            d.it("should keep the most bytes seen for a path", []() {
+                Serialization serialization;
+                DynamicJsonDocument doc(docSize);
+                deserializeJson(doc, json);
+                Accounting::reset();
+                serialization.deserialize(doc.as<JsonVariant>());
+                auto most = Accounting::find(networkPath)->highWater;
+                deserializeJson(doc, "{\"network\":{}}");
+                serialization.deserialize(doc.as<JsonVariant>());
+                TEST_ASSERT_EQUAL(0, Accounting::find(networkPath)->deserialized.bytes);
+                TEST_ASSERT_EQUAL(most, Accounting::find(networkPath)->highWater);
+            });
+        });
+        d.describe("reset", [](Describe & d) {
+            d.it("should forget every path", []() {
+                Serialization serialization;
+                DynamicJsonDocument doc(docSize);
+                deserializeJson(doc, json);
+                serialization.deserialize(doc.as<JsonVariant>());
+                Accounting::reset();
+                TEST_ASSERT_EQUAL(0, Accounting::count());
+                TEST_ASSERT_NULL(Accounting::find(rootPath));
+            });
+        });
+    });
+
+#else
+
+    Module tests("MemoryAccounting", [](Describe & d) {
+        d.describe("when disabled", [](Describe & d) {
+            d.it("should leave an empty scope that compiles to nothing", []() {
+                TEST_ASSERT_TRUE(std::is_empty<Accounting::Scope>::value);
+            });
+        });
+    });
+
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include <unity.h>
+#include "../src/BurpSerialization/MsgPackParser.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "../src/BurpSerialization/IPv4.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "MsgPackParser.hpp"
+
+namespace MsgPackParser {
+
+    constexpr size_t bufferSize = 128;
+    constexpr size_t smallBufferSize = 8;
+    constexpr char nameName[] = "name";
+    constexpr char countName[] = "count";
+    constexpr char levelsName[] = "levels";
+    constexpr char addressName[] = "address";
+    constexpr char macName[] = "mac";
+    constexpr char validName[] = "a \"name\"";
+    constexpr int validCount = -1000;
+    constexpr uint32_t validAddress = 0xc0a80101;
+    constexpr uint8_t validMac[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab};
+    // {"other": {"nested": [1, {"a": "b"}]}, "name": "name", "count": 42, "levels": bin [1]}
+    constexpr uint8_t unknownMembersMsgPack[] = {
+        0x84,
+        0xa5, 'o', 't', 'h', 'e', 'r', 0x81, 0xa6, 'n', 'e', 's', 't', 'e', 'd', 0x92, 0x01, 0x81, 0xa1, 'a', 0xa1, 'b',
+        0xa4, 'n', 'a', 'm', 'e', 0xa4, 'n', 'a', 'm', 'e',
+        0xa5, 'c', 'o', 'u', 'n', 't', 0x2a,
+        0xa6, 'l', 'e', 'v', 'e', 'l', 's', 0xc4, 0x01, 0x01
+    };
+    // {"name": "name", "count": 42, "levels": [1, {"a": 1}, 2]}
+    constexpr uint8_t invalidLevelsMsgPack[] = {
+        0x83,
+        0xa4, 'n', 'a', 'm', 'e', 0xa4, 'n', 'a', 'm', 'e',
+        0xa5, 'c', 'o', 'u', 'n', 't', 0x2a,
+        0xa6, 'l', 'e', 'v', 'e', 'l', 's', 0x93, 0x01, 0x81, 0xa1, 'a', 0x01, 0x02
+    };
+    // {"levels": bin [1], "name": "name"}
+    constexpr uint8_t missingCountMsgPack[] = {
+        0x82,
+        0xa6, 'l', 'e', 'v', 'e', 'l', 's', 0xc4, 0x01, 0x01,
+        0xa4, 'n', 'a', 'm', 'e', 0xa4, 'n', 'a', 'm', 'e'
+    };
+    // {"name": "name", "count": bin [1], "levels": bin [1]}
+    constexpr uint8_t binaryCountMsgPack[] = {
+        0x83,
+        0xa4, 'n', 'a', 'm', 'e', 0xa4, 'n', 'a', 'm', 'e',
+        0xa5, 'c', 'o', 'u', 'n', 't', 0xc4, 0x01, 0x01,
+        0xa6, 'l', 'e', 'v', 'e', 'l', 's', 0xc4, 0x01, 0x01
+    };
+    // {1: 2}
+    constexpr uint8_t integerKeyMsgPack[] = {0x81, 0x01, 0x02};
+    // {"name": fixext 1}
+    constexpr uint8_t extensionMsgPack[] = {0x81, 0xa4, 'n', 'a', 'm', 'e', 0xd4, 0x00, 0x00};
+    // {"name": "na
+    constexpr uint8_t truncatedMsgPack[] = {0x82, 0xa4, 'n', 'a', 'm', 'e', 0xa4, 'n', 'a'};
+    constexpr uint8_t scalarMsgPack[] = {0x2a};
+    constexpr uint8_t tooDeepMsgPack[] = {
+        0x91, 0x91, 0x91, 0x91, 0x91, 0x91, 0x91, 0x91,
+        0x91, 0x91, 0x91, 0x91, 0x91, 0x91, 0x91, 0x91,
+        0x91, 0x01
+    };
+
+    class Parser : public BurpSerialization::MsgPackParser {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                incomplete,
+                invalidInput,
+                tooDeep,
+                noMemory,
+                notPresent,
+                wrongType,
+                nameNotPresent,
+                nameWrongType,
+                nameTooShort,
+                nameTooLong,
+                countNotPresent,
+                countWrongType,
+                levelsNotPresent,
+                levelsWrongType,
+                levelsTooLong,
+                levelsTooShort,
+                levelZero,
+                levelNotIncreasing,
+                levelNotPresent,
+                levelWrongType,
+                addressWrongType,
+                addressInvalidCharacter,
+                addressOutOfRange,
+                addressMissingField,
+                addressExcessCharacters,
+                macWrongType,
+                macInvalidCharacter,
+                macInvalidSeparator,
+                macOutOfRange,
+                macMissingField,
+                macExcessCharacters
+            };
+
+            struct {
+                bool isNull;
+                const char * name;
+                BurpSerialization::Scalar<int>::Value count;
+                BurpSerialization::PWMLevels::Value levels;
+                BurpSerialization::IPv4::Value address;
+                BurpSerialization::MacAddress::Value mac;
+            } obj;
+
+            Parser(char * buffer, size_t size) :
+                BurpSerialization::MsgPackParser(_obj, buffer, size, {
+                    ok,
+                    incomplete,
+                    invalidInput,
+                    tooDeep,
+                    noMemory
+                }),
+                _name(1, 16, {
+                    ok,
+                    nameNotPresent,
+                    nameWrongType,
+                    nameTooShort,
+                    nameTooLong
+                }, obj.name),
+                _count({
+                    ok,
+                    countNotPresent,
+                    countWrongType
+                }, obj.count),
+                _levels({
+                    ok,
+                    levelsNotPresent,
+                    levelsWrongType,
+                    levelsTooLong,
+                    levelsTooShort,
+                    levelZero,
+                    levelNotIncreasing,
+                    levelNotPresent,
+                    levelWrongType
+                }, obj.levels),
+                // the address and mac are not required
+                _address({
+                    ok,
+                    ok,
+                    addressWrongType,
+                    addressInvalidCharacter,
+                    addressOutOfRange,
+                    addressMissingField,
+                    addressExcessCharacters
+                }, obj.address),
+                _mac({
+                    ok,
+                    ok,
+                    macWrongType,
+                    macInvalidCharacter,
+                    macInvalidSeparator,
+                    macOutOfRange,
+                    macMissingField,
+                    macExcessCharacters
+                }, obj.mac),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count}),
+                    Object::Entry({levelsName, &_levels}),
+                    Object::Entry({addressName, &_address}),
+                    Object::Entry({macName, &_mac})
+                }, {
+                    ok,
+                    notPresent,
+                    wrongType
+                }, obj.isNull)
+            {}
+
+            BurpStatus::Status::Code parse(const uint8_t * msgPack, size_t length, size_t chunkSize) {
+                begin();
+                for (size_t pos = 0; pos < length; pos += chunkSize) {
+                    auto code = write(msgPack + pos, pos + chunkSize < length ? chunkSize : length - pos);
+                    if (code != ok) return code;
+                }
+                return end();
+            }
+
+            // fill in the valid values and encode them
+            size_t encode(char * buffer, size_t size) {
+                obj.isNull = false;
+                obj.name = validName;
+                obj.count.isNull = false;
+                obj.count.value = validCount;
+                obj.levels.isNull = false;
+                obj.levels.list = {1, 2, 3};
+                obj.levels.length = 3;
+                obj.address.isNull = false;
+                obj.address.value = validAddress;
+                obj.mac.isNull = false;
+                memcpy(obj.mac.value, validMac, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+                BurpSerialization::Writer writer(buffer, size, BurpSerialization::Writer::Format::msgPack);
+                if (!_obj.write(writer)) return 0;
+                obj = {};
+                return writer.length();
+            }
+
+        private:
+
+            using Object = BurpSerialization::Object<5>;
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::Scalar<int> _count;
+            const BurpSerialization::PWMLevels _levels;
+            const BurpSerialization::IPv4 _address;
+            const BurpSerialization::MacAddress _mac;
+            const Object _obj;
+
+    };
+
+    void assertValid(Parser & parser) {
+        TEST_ASSERT_FALSE(parser.obj.isNull);
+        TEST_ASSERT_EQUAL_STRING(validName, parser.obj.name);
+        TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+        TEST_ASSERT_EQUAL(3, parser.obj.levels.length);
+        TEST_ASSERT_EQUAL(3, parser.obj.levels.list[2]);
+        TEST_ASSERT_FALSE(parser.obj.address.isNull);
+        TEST_ASSERT_EQUAL(validAddress, parser.obj.address.value);
+        TEST_ASSERT_FALSE(parser.obj.mac.isNull);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(validMac, parser.obj.mac.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+    }
+
+    Module tests("MsgPackParser", [](Describe & d) {
+        d.describe("with a written document in one chunk", [](Describe & d) {
+            d.it("should read back the same values", []() {
+                char buffer[bufferSize];
+                char msgPack[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto length = parser.encode(msgPack, bufferSize);
+                TEST_ASSERT_NOT_EQUAL(0, length);
+                auto code = parser.parse(reinterpret_cast<const uint8_t *>(msgPack), length, length);
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                assertValid(parser);
+            });
+        });
+        d.describe("with a written document one byte at a time", [](Describe & d) {
+            d.it("should read back the same values", []() {
+                char buffer[bufferSize];
+                char msgPack[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto length = parser.encode(msgPack, bufferSize);
+                auto code = parser.parse(reinterpret_cast<const uint8_t *>(msgPack), length, 1);
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                assertValid(parser);
+            });
+        });
+        d.describe("with unknown members", [](Describe & d) {
+            d.it("should skip them", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(unknownMembersMsgPack, sizeof(unknownMembersMsgPack), 5);
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                TEST_ASSERT_EQUAL_STRING("name", parser.obj.name);
+                TEST_ASSERT_EQUAL(42, parser.obj.count.value);
+                TEST_ASSERT_EQUAL(1, parser.obj.levels.length);
+            });
+        });
+        d.describe("with a container in place of a level", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(invalidLevelsMsgPack, sizeof(invalidLevelsMsgPack), 7);
+                TEST_ASSERT_EQUAL(Parser::levelWrongType, code);
+                TEST_ASSERT_TRUE(parser.obj.levels.isNull);
+            });
+        });
+        d.describe("with bin for a field without a binary form", [](Describe & d) {
+            d.it("should fail with the wrong type", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(binaryCountMsgPack, sizeof(binaryCountMsgPack), 3);
+                TEST_ASSERT_EQUAL(Parser::countWrongType, code);
+                TEST_ASSERT_TRUE(parser.obj.count.isNull);
+            });
+        });
+        d.describe("with a missing member", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(missingCountMsgPack, sizeof(missingCountMsgPack), 3);
+                TEST_ASSERT_EQUAL(Parser::countNotPresent, code);
+                TEST_ASSERT_FALSE(parser.obj.isNull);
+                TEST_ASSERT_TRUE(parser.obj.count.isNull);
+                TEST_ASSERT_EQUAL_STRING("name", parser.obj.name);
+            });
+        });
+        d.describe("with a key that is not a string", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(integerKeyMsgPack, sizeof(integerKeyMsgPack), 1);
+                TEST_ASSERT_EQUAL(Parser::invalidInput, code);
+            });
+        });
+        d.describe("with an extension type", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(extensionMsgPack, sizeof(extensionMsgPack), 4);
+                TEST_ASSERT_EQUAL(Parser::invalidInput, code);
+            });
+        });
+        d.describe("with a truncated document", [](Describe & d) {
+            d.it("should be incomplete", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(truncatedMsgPack, sizeof(truncatedMsgPack), 4);
+                TEST_ASSERT_EQUAL(Parser::incomplete, code);
+            });
+        });
+        d.describe("with a buffer that is too small", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[smallBufferSize];
+                char msgPack[bufferSize];
+                Parser parser(buffer, smallBufferSize);
+                auto length = parser.encode(msgPack, bufferSize);
+                auto code = parser.parse(reinterpret_cast<const uint8_t *>(msgPack), length, 4);
+                TEST_ASSERT_EQUAL(Parser::noMemory, code);
+            });
+        });
+        d.describe("with a scalar at the root", [](Describe & d) {
+            d.it("should fail with the wrong type", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(scalarMsgPack, sizeof(scalarMsgPack), 1);
+                TEST_ASSERT_EQUAL(Parser::wrongType, code);
+                TEST_ASSERT_TRUE(parser.obj.isNull);
+            });
+        });
+        d.describe("with containers nested too deeply", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(tooDeepMsgPack, sizeof(tooDeepMsgPack), 1);
+                TEST_ASSERT_EQUAL(Parser::tooDeep, code);
+            });
+        });
+    });
+
+}
\ No newline at end of file
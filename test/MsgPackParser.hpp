@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace MsgPackParser {
+    
+  extern Module tests;
+
+}
\ No newline at end of file
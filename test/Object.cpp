@@ -1,4 +1,8 @@
 #include <unity.h>
+#ifdef BURP_NATIVE
+#include <string>
+#include <vector>
+#endif
 #include "../src/BurpSerialization/Object.hpp"
 #include "../src/BurpSerialization/Serialization.hpp"
 #include "TestField.hpp"
@@ -7,17 +11,30 @@
 namespace Object {
 
     constexpr size_t docSize = 128;
+    constexpr size_t largeDocSize = 256;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 4;
+#ifdef BURP_NATIVE
+    constexpr size_t longNameLength = 0x8000;
+#endif
     constexpr size_t entryCount = 3;
     constexpr char fieldName[] = "field";
     constexpr char fieldOneName[] = "one";
     constexpr char fieldTwoName[] = "two";
     constexpr char fieldThreeName[] = "three";
+    constexpr char unknownName[] = "four";
     constexpr int invalidCStr = 100;
     constexpr char validOneCStr[] = "one value";
     constexpr char validTwoCStr[] = "two value";
     constexpr char validThreeCStr[] = "three value";
+    constexpr char validJson[] = "{\"one\":\"one value\",\"two\":null,\"three\":\"three value\"}";
+    constexpr uint8_t nullsMsgPack[] = {0x83, 0xa3, 'o', 'n', 'e', 0xc0, 0xa3, 't', 'w', 'o', 0xc0, 0xa5, 't', 'h', 'r', 'e', 'e', 0xc0};
+    const char flashOneName[] PROGMEM = "one";
+    const char flashTwoName[] PROGMEM = "two";
+    const char flashThreeName[] PROGMEM = "three";
 
-    class Serialization : public BurpSerialization::Serialization {
+    template <class Name>
+    class BasicSerialization : public BurpSerialization::Serialization {
 
         public:
 
@@ -38,10 +55,10 @@ namespace Object {
                 const char * fieldOne;
                 const char * fieldTwo;
                 const char * fieldThree;
-            } obj;
+            } obj = {};
 
-            Serialization() :
-                BurpSerialization::Serialization(_obj),
+            BasicSerialization(const Name oneName, const Name twoName, const Name threeName, const Mode mode = Mode::collectAll) :
+                BurpSerialization::Serialization(_obj, mode),
                 _fieldOne({
                     ok,
                     fieldOneNotPresent,
@@ -58,9 +75,9 @@ namespace Object {
                     fieldThreeWrongType
                 }, obj.fieldThree),
                 _obj({
-                    Object::Entry({fieldOneName, &_fieldOne}),
-                    Object::Entry({fieldTwoName, &_fieldTwo}),
-                    Object::Entry({fieldThreeName, &_fieldThree})
+                    typename Object::Entry({oneName, &_fieldOne}),
+                    typename Object::Entry({twoName, &_fieldTwo}),
+                    typename Object::Entry({threeName, &_fieldThree})
                 }, {
                     ok,
                     notPresent,
@@ -70,7 +87,7 @@ namespace Object {
 
         private:
 
-            using Object = BurpSerialization::Object<entryCount>;
+            using Object = BurpSerialization::Object<entryCount, BurpSerialization::CopiedCodes, Name>;
 
             const TestField _fieldOne;
             const TestField _fieldTwo;
@@ -79,6 +96,41 @@ namespace Object {
 
     };
 
+    class Serialization : public BasicSerialization<const char *> {
+
+        public:
+
+            Serialization() :
+                BasicSerialization(fieldOneName, fieldTwoName, fieldThreeName)
+            {}
+
+    };
+
+    class FailFastSerialization : public BasicSerialization<const char *> {
+
+        public:
+
+            FailFastSerialization() :
+                BasicSerialization(fieldOneName, fieldTwoName, fieldThreeName, Mode::failFast)
+            {}
+
+    };
+
+    // the same schema with the names in flash
+    class FlashSerialization : public BasicSerialization<const BurpSerialization::FlashString *> {
+
+        public:
+
+            FlashSerialization() :
+                BasicSerialization(
+                    BurpSerialization::flashString(flashOneName),
+                    BurpSerialization::flashString(flashTwoName),
+                    BurpSerialization::flashString(flashThreeName)
+                )
+            {}
+
+    };
+
     Module tests("Object", [](Describe & d) {
         d.describe("deserialize", [](Describe & d) {
             d.describe("when not present", [](Describe & d) {
@@ -143,6 +195,183 @@ namespace Object {
             });
         });
 
+        d.describe("deserialize out of order", [](Describe & d) {
+            d.describe("with members in reverse order", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with unknown members", [](Describe & d) {
+                d.it("should ignore them", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<largeDocSize> doc;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][unknownName] = invalidCStr;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("when several sub fields fail", [](Describe & d) {
+                d.it("should report the last failure in entry order", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldThreeName] = invalidCStr;
+                    doc[fieldName][fieldOneName] = invalidCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::fieldThreeWrongType, code);
+                });
+            });
+        });
+
+        d.describe("deserialize fail fast", [](Describe & d) {
+            d.describe("when several sub fields fail", [](Describe & d) {
+                d.it("should report the first failure in document order and stay null", []() {
+                    FailFastSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldThreeName] = invalidCStr;
+                    doc[fieldName][fieldOneName] = invalidCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::fieldThreeWrongType, code);
+                });
+            });
+            d.describe("when a sub field fails", [](Describe & d) {
+                d.it("should not read the later members", []() {
+                    FailFastSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = invalidCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_NULL(serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL(Serialization::fieldOneWrongType, code);
+                });
+            });
+            d.describe("when a sub field is not present", [](Describe & d) {
+                d.it("should report the first missing one in entry order", []() {
+                    FailFastSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::fieldOneNotPresent, code);
+                });
+            });
+            d.describe("with a valid object", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    FailFastSerialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("deserializePatch", [](Describe & d) {
+            d.describe("with some members", [](Describe & d) {
+                d.it("should update only those members", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    serialization.deserialize(doc[fieldName]);
+                    StaticJsonDocument<docSize> patch;
+                    patch[fieldName][fieldTwoName] = validOneCStr;
+                    auto code = serialization.deserializePatch(patch[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with a null member", [](Describe & d) {
+                d.it("should remove only that member", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    serialization.deserialize(doc[fieldName]);
+                    StaticJsonDocument<docSize> patch;
+                    deserializeJson(patch, "{\"two\":null}");
+                    auto code = serialization.deserializePatch(patch.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_NULL(serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::fieldTwoNotPresent, code);
+                });
+            });
+            d.describe("with an invalid member", [](Describe & d) {
+                d.it("should report only that member", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    serialization.deserialize(doc[fieldName]);
+                    StaticJsonDocument<docSize> patch;
+                    patch[fieldName][fieldOneName] = invalidCStr;
+                    auto code = serialization.deserializePatch(patch[fieldName]);
+                    TEST_ASSERT_NULL(serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::fieldOneWrongType, code);
+                });
+            });
+            d.describe("when the object is null", [](Describe & d) {
+                d.it("should start from an empty object", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<1> empty;
+                    serialization.deserialize(empty[fieldName]);
+                    StaticJsonDocument<docSize> patch;
+                    patch[fieldName][fieldOneName] = validOneCStr;
+                    patch[fieldName][fieldTwoName] = validTwoCStr;
+                    auto code = serialization.deserializePatch(patch[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_NULL(serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(Serialization::fieldThreeNotPresent, code);
+                });
+            });
+            d.describe("with null", [](Describe & d) {
+                d.it("should remove the object", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    serialization.deserialize(doc[fieldName]);
+                    StaticJsonDocument<docSize> patch;
+                    deserializeJson(patch, "null");
+                    auto code = serialization.deserializePatch(patch.as<JsonVariant>());
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::notPresent, code);
+                });
+            });
+        });
+
         d.describe("serialize", [](Describe & d) {
             d.describe("with a value that is too big for the document", [](Describe & d) {
                 d.it("should fail", []() {
@@ -182,6 +411,130 @@ namespace Object {
                 });
             });
         });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = validOneCStr;
+                    serialization.obj.fieldTwo = nullptr;
+                    serialization.obj.fieldThree = validThreeCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.obj.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = validOneCStr;
+                    serialization.obj.fieldTwo = nullptr;
+                    serialization.obj.fieldThree = validThreeCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validJson, buffer);
+                });
+            });
+#ifdef BURP_NATIVE
+            d.describe("with a name too long to keep its length", [](Describe & d) {
+                d.it("should measure it again", []() {
+                    std::string longName(longNameLength, 'a');
+                    BasicSerialization<const char *> serialization(longName.c_str(), fieldTwoName, fieldThreeName);
+                    std::vector<char> buffer(longNameLength + bufferSize);
+                    BurpSerialization::Writer writer(buffer.data(), buffer.size());
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = validOneCStr;
+                    serialization.obj.fieldTwo = nullptr;
+                    serialization.obj.fieldThree = validThreeCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    auto expected = "{\"" + longName + "\":\"one value\",\"two\":null,\"three\":\"three value\"}";
+                    TEST_ASSERT_EQUAL_STRING(expected.c_str(), buffer.data());
+                });
+            });
+#endif
+        });
+
+        d.describe("with names in flash", [](Describe & d) {
+            d.describe("deserialize out of order", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    FlashSerialization serialization;
+                    StaticJsonDocument<largeDocSize> doc;
+                    doc[fieldName][fieldThreeName] = validThreeCStr;
+                    doc[fieldName][unknownName] = invalidCStr;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, serialization.obj.fieldThree);
+                    TEST_ASSERT_EQUAL(FlashSerialization::ok, code);
+                });
+            });
+            d.describe("serialize", [](Describe & d) {
+                d.it("should copy the names into the JSON document", []() {
+                    FlashSerialization serialization;
+                    StaticJsonDocument<largeDocSize> doc;
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = validOneCStr;
+                    serialization.obj.fieldTwo = validTwoCStr;
+                    serialization.obj.fieldThree = validThreeCStr;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, doc[fieldName][fieldOneName]);
+                    TEST_ASSERT_EQUAL_STRING(validThreeCStr, doc[fieldName][fieldThreeName]);
+                    auto first = *doc[fieldName].as<JsonObject>().begin();
+                    TEST_ASSERT_EQUAL_STRING(fieldOneName, first.key().c_str());
+                    TEST_ASSERT_TRUE(first.key().c_str() != flashOneName);
+                });
+            });
+            d.describe("write", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    FlashSerialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = validOneCStr;
+                    serialization.obj.fieldTwo = nullptr;
+                    serialization.obj.fieldThree = validThreeCStr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validJson, buffer);
+                });
+            });
+            d.describe("write as MessagePack", [](Describe & d) {
+                d.it("should write the names", []() {
+                    FlashSerialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    serialization.obj.isNull = false;
+                    serialization.obj.fieldOne = nullptr;
+                    serialization.obj.fieldTwo = nullptr;
+                    serialization.obj.fieldThree = nullptr;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(nullsMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_MEMORY(nullsMsgPack, buffer, sizeof(nullsMsgPack));
+                });
+            });
+        });
     });
 
 }
\ No newline at end of file
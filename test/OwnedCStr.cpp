@@ -0,0 +1,208 @@
+#include <unity.h>
+#include "../src/BurpSerialization/OwnedCStr.hpp"
+#include "../src/BurpSerialization/Serialization.hpp"
+#include "../src/BurpSerialization/BinaryEncoder.hpp"
+#include "../src/BurpSerialization/BinaryDecoder.hpp"
+#include "OwnedCStr.hpp"
+
+namespace OwnedCStr {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 64;
+    constexpr size_t minLength = 5;
+    constexpr size_t maxLength = 10;
+    constexpr char fieldName[] = "field";
+    constexpr int invalidCStr = 100;
+    constexpr char shortCStr[] = "0123";
+    constexpr char longCStr[] = "01234567890";
+    constexpr char minCStr[] = "01234";
+    constexpr char maxCStr[] = "0123456789";
+
+    class Serialization : public BurpSerialization::Serialization {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                notPresent,
+                wrongType,
+                tooShort,
+                tooLong
+            };
+
+            using Field = BurpSerialization::OwnedCStr<maxLength>;
+
+            Field::Value cstr;
+
+            Serialization() :
+                BurpSerialization::Serialization(_cstr),
+                _cstr(minLength, {
+                    ok,
+                    notPresent,
+                    wrongType,
+                    tooShort,
+                    tooLong
+                }, cstr)
+            {}
+
+            void set(const char * value) {
+                cstr.isNull = false;
+                strcpy(cstr.value, value);
+            }
+
+        private:
+
+            const Field _cstr;
+
+    };
+
+    Module tests("OwnedCStr", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("when not present", [](Describe & d) {
+                d.it("should fail and be null", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<1> doc;
+                    serialization.set(maxCStr);
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::notPresent, code);
+                });
+            });
+            d.describe("with an invalid value", [](Describe & d) {
+                d.it("should fail and be null", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = invalidCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::wrongType, code);
+                });
+            });
+            d.describe("with a value that is too short", [](Describe & d) {
+                d.it("should fail and be null", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = shortCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL_STRING("", serialization.cstr.value);
+                    TEST_ASSERT_EQUAL(Serialization::tooShort, code);
+                });
+            });
+            d.describe("with a value that is too long", [](Describe & d) {
+                d.it("should fail and be null", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = longCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL_STRING("", serialization.cstr.value);
+                    TEST_ASSERT_EQUAL(Serialization::tooLong, code);
+                });
+            });
+            d.describe("with a min length value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = minCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL_STRING(minCStr, serialization.cstr.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with a max length value", [](Describe & d) {
+                d.it("should not fail and have the correct value", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = maxCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL_STRING(maxCStr, serialization.cstr.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("from a document that is then freed", [](Describe & d) {
+                d.it("should keep the value", []() {
+                    Serialization serialization;
+                    {
+                        DynamicJsonDocument doc(docSize);
+                        char json[] = "{\"field\":\"0123456789\"}";
+                        deserializeJson(doc, json);
+                        serialization.deserialize(doc[fieldName]);
+                        memset(json, 0, sizeof(json));
+                    }
+                    TEST_ASSERT_FALSE(serialization.cstr.isNull);
+                    TEST_ASSERT_EQUAL_STRING(maxCStr, serialization.cstr.value);
+                });
+            });
+        });
+
+        d.describe("serialize", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should set the value in the JSON document to NULL", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = maxCStr;
+                    serialization.cstr.isNull = true;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(doc[fieldName].isNull());
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should set the value in the JSON document", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.set(maxCStr);
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(maxCStr, doc[fieldName]);
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.cstr.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.set(maxCStr);
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("\"0123456789\"", buffer);
+                });
+            });
+        });
+
+        d.describe("with the binary codec", [](Describe & d) {
+            d.it("should copy the value out of the decoder buffer", []() {
+                Serialization serialization;
+                uint8_t buffer[bufferSize];
+                char strings[bufferSize];
+                serialization.set(minCStr);
+                BurpSerialization::BinaryEncoder encoder(buffer, bufferSize);
+                TEST_ASSERT_TRUE(serialization.serialize(encoder));
+                serialization.set(maxCStr);
+                BurpSerialization::BinaryDecoder decoder(strings, bufferSize, {0, 1, 2, 3, 4});
+                auto code = serialization.deserialize(decoder, buffer, encoder.length());
+                memset(strings, 0, sizeof(strings));
+                TEST_ASSERT_EQUAL(Serialization::ok, code);
+                TEST_ASSERT_EQUAL_STRING(minCStr, serialization.cstr.value);
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace OwnedCStr {
+    
+  extern Module tests;
+
+}
\ No newline at end of file
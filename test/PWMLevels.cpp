@@ -6,13 +6,18 @@
 namespace PWMLevels {
 
     constexpr size_t docSize = 10000;
+    constexpr size_t bufferSize = 1024;
+    constexpr size_t smallBufferSize = 4;
     constexpr char fieldName[] = "field";
     constexpr char invalidLevel[] = "hello";
-    BurpSerialization::PWMLevels::List longList = {};
+    constexpr uint8_t validMsgPack[] = {0xc4, 3, 1, 2, 3};
     BurpSerialization::PWMLevels::List fullList = {};
     BurpSerialization::PWMLevels::List shortList = {};
 
-    class Serialization : public BurpSerialization::Serialization {
+    constexpr size_t smallLevels = 8;
+
+    template <class Levels>
+    class BasicSerialization : public BurpSerialization::Serialization {
 
         public:
 
@@ -28,10 +33,10 @@ namespace PWMLevels {
                 levelWrongType
             };
 
-            BurpSerialization::PWMLevels::Value pwmLevels;
+            typename Levels::Value pwmLevels;
 
-            Serialization() :
-                BurpSerialization::Serialization(_pwmLevels),
+            BasicSerialization(const Mode mode = Mode::collectAll) :
+                BurpSerialization::Serialization(_pwmLevels, mode),
                 _pwmLevels({
                     ok,
                     notPresent,
@@ -47,15 +52,15 @@ namespace PWMLevels {
 
         private:
 
-            const BurpSerialization::PWMLevels _pwmLevels;
+            const Levels _pwmLevels;
 
     };
 
+    using Serialization = BasicSerialization<BurpSerialization::PWMLevels>;
+    using SmallSerialization = BasicSerialization<BurpSerialization::BasicPWMLevels<BurpSerialization::CopiedCodes, smallLevels>>;
+
     Module tests("PWMLevels", [](Describe & d) {
         d.before([]() {
-            for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels + 1; index++) {
-                longList[index] = (index % 255) + 1 ;
-            }
             for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels; index++) {
                 fullList[index] = (index % 255) + 1;
             }
@@ -164,7 +169,7 @@ namespace PWMLevels {
                     auto code = serialization.deserialize(doc[fieldName]);
                     TEST_ASSERT_FALSE(serialization.pwmLevels.isNull);
                     TEST_ASSERT_EQUAL(BurpSerialization::PWMLevels::maxLevels, serialization.pwmLevels.length);
-                    for (size_t index = 0; index < fullList.size(); index++) {
+                    for (size_t index = 0; index < serialization.pwmLevels.length; index++) {
                         TEST_ASSERT_EQUAL(fullList[index], serialization.pwmLevels.list[index]);
                     }
                     TEST_ASSERT_EQUAL(Serialization::ok, code);
@@ -180,7 +185,117 @@ namespace PWMLevels {
                     auto code = serialization.deserialize(doc[fieldName]);
                     TEST_ASSERT_FALSE(serialization.pwmLevels.isNull);
                     TEST_ASSERT_EQUAL(BurpSerialization::PWMLevels::maxLevels - 1, serialization.pwmLevels.length);
-                    for (size_t index = 0; index < shortList.size(); index++) {
+                    for (size_t index = 0; index < serialization.pwmLevels.length; index++) {
+                        TEST_ASSERT_EQUAL(shortList[index], serialization.pwmLevels.list[index]);
+                    }
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("checking the order", [](Describe & d) {
+            d.describe("with a level out of order deep in a long array", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    for (size_t index = 0; index < 40; index++) {
+                        doc[fieldName].add(index == 37 ? 36 : index + 1);
+                    }
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::levelNotIncreasing, code);
+                });
+            });
+            d.describe("with an order error before an invalid level", [](Describe & d) {
+                d.it("should report the order error", []() {
+                    Serialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    doc[fieldName].add(2);
+                    doc[fieldName].add(1);
+                    doc[fieldName].add(invalidLevel);
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_EQUAL(Serialization::levelNotIncreasing, code);
+                });
+            });
+            d.describe("with an invalid level before an order error", [](Describe & d) {
+                d.it("should report the invalid level", []() {
+                    Serialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    doc[fieldName].add(1);
+                    doc[fieldName].add(invalidLevel);
+                    doc[fieldName].add(0);
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_EQUAL(Serialization::levelWrongType, code);
+                });
+            });
+        });
+
+        d.describe("with a small capacity", [](Describe & d) {
+            d.describe("when the array is too long", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    SmallSerialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    for (size_t index = 0; index < smallLevels + 1; index++) {
+                        doc[fieldName].add(index + 1);
+                    }
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(SmallSerialization::tooLong, code);
+                });
+            });
+            d.describe("with a full array", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    SmallSerialization serialization;
+                    DynamicJsonDocument doc(docSize);
+                    for (size_t index = 0; index < smallLevels; index++) {
+                        doc[fieldName].add((index + 1) * 10);
+                    }
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(smallLevels, serialization.pwmLevels.length);
+                    TEST_ASSERT_EQUAL(80, serialization.pwmLevels.list[smallLevels - 1]);
+                    TEST_ASSERT_EQUAL(SmallSerialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("deserialize fail fast", [](Describe & d) {
+            d.describe("when a level is invalid", [](Describe & d) {
+                d.it("should fail with the first bad level and not be present", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    DynamicJsonDocument doc(docSize);
+                    doc[fieldName].add(1);
+                    doc[fieldName].add(0);
+                    doc[fieldName].add(invalidLevel);
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::levelZero, code);
+                });
+            });
+            d.describe("when the array is too long", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    DynamicJsonDocument doc(docSize);
+                    doc[fieldName].add(0);
+                    for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels; index++) {
+                        doc[fieldName].add(index + 1);
+                    }
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::tooLong, code);
+                });
+            });
+            d.describe("with a short array", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    DynamicJsonDocument doc(docSize);
+                    for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels - 1; index++) {
+                        doc[fieldName].add(index + 1);
+                    }
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.pwmLevels.isNull);
+                    TEST_ASSERT_EQUAL(BurpSerialization::PWMLevels::maxLevels - 1, serialization.pwmLevels.length);
+                    for (size_t index = 0; index < serialization.pwmLevels.length; index++) {
                         TEST_ASSERT_EQUAL(shortList[index], serialization.pwmLevels.list[index]);
                     }
                     TEST_ASSERT_EQUAL(Serialization::ok, code);
@@ -194,6 +309,7 @@ namespace PWMLevels {
                     Serialization serialization;
                     DynamicJsonDocument doc(1);
                     serialization.pwmLevels.list = fullList;
+                    serialization.pwmLevels.length = BurpSerialization::PWMLevels::maxLevels;
                     auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
                     TEST_ASSERT_FALSE(success);
                 });
@@ -208,11 +324,11 @@ namespace PWMLevels {
                     TEST_ASSERT_TRUE(doc[fieldName].isNull());
                 });
             });
-            d.describe("with a long list of values", [](Describe & d) {
+            d.describe("with a length over the capacity", [](Describe & d) {
                 d.it("should fail", []() {
-                    Serialization serialization;
+                    SmallSerialization serialization;
                     DynamicJsonDocument doc(docSize);
-                    serialization.pwmLevels.list = longList;
+                    serialization.pwmLevels.length = smallLevels + 1;
                     auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
                     TEST_ASSERT_FALSE(success);
                 });
@@ -222,6 +338,7 @@ namespace PWMLevels {
                     Serialization serialization;
                     DynamicJsonDocument doc(docSize);
                     serialization.pwmLevels.list = fullList;
+                    serialization.pwmLevels.length = BurpSerialization::PWMLevels::maxLevels;
                     auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
                     TEST_ASSERT_TRUE(success);
                     for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels; index++) {
@@ -235,6 +352,7 @@ namespace PWMLevels {
                     Serialization serialization;
                     DynamicJsonDocument doc(docSize);
                     serialization.pwmLevels.list = shortList;
+                    serialization.pwmLevels.length = BurpSerialization::PWMLevels::maxLevels - 1;
                     auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
                     TEST_ASSERT_TRUE(success);
                     for (size_t index = 0; index < BurpSerialization::PWMLevels::maxLevels - 1; index++) {
@@ -244,6 +362,66 @@ namespace PWMLevels {
                 });
             });
         });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with a buffer that is too small", [](Describe & d) {
+                d.it("should fail", []() {
+                    Serialization serialization;
+                    char buffer[smallBufferSize];
+                    BurpSerialization::Writer writer(buffer, smallBufferSize);
+                    serialization.pwmLevels.list = {1, 2, 3};
+                    serialization.pwmLevels.length = 3;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("without a value", [](Describe & d) {
+                d.it("should write null", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.pwmLevels.isNull = true;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("null", buffer);
+                });
+            });
+            d.describe("with a value", [](Describe & d) {
+                d.it("should write the JSON text", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.pwmLevels.list = {1, 2, 3};
+                    serialization.pwmLevels.length = 3;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING("[1,2,3]", buffer);
+                });
+            });
+            d.describe("with a length over the capacity", [](Describe & d) {
+                d.it("should fail", []() {
+                    SmallSerialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.pwmLevels.length = smallLevels + 1;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_FALSE(success);
+                });
+            });
+            d.describe("with a value as MessagePack", [](Describe & d) {
+                d.it("should write the levels as bin", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize, BurpSerialization::Writer::Format::msgPack);
+                    serialization.pwmLevels.list = {1, 2, 3};
+                    serialization.pwmLevels.length = 3;
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL(sizeof(validMsgPack), writer.length());
+                    TEST_ASSERT_EQUAL_UINT8_ARRAY(validMsgPack, buffer, sizeof(validMsgPack));
+                });
+            });
+        });
     });
 
 }
\ No newline at end of file
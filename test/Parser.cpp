@@ -0,0 +1,316 @@
+#include <unity.h>
+#include "../src/BurpSerialization/Parser.hpp"
+#include "../src/BurpSerialization/Object.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/PWMLevels.hpp"
+#include "../src/BurpSerialization/MacAddress.hpp"
+#include "Parser.hpp"
+
+namespace Parser {
+
+    constexpr size_t bufferSize = 64;
+    constexpr size_t smallBufferSize = 8;
+    constexpr char nameName[] = "name";
+    constexpr char countName[] = "count";
+    constexpr char levelsName[] = "levels";
+    constexpr char validJson[] = "{\"name\": \"a \\\"name\\\"\", \"count\": 42, \"levels\": [1, 2, 3]}";
+    constexpr char validName[] = "a \"name\"";
+    constexpr int validCount = 42;
+    constexpr char unknownMembersJson[] = "{\"other\": {\"nested\": [1, {\"a\": \"b\"}]}, \"name\": \"name\", \"count\": 42, \"levels\": [1]}";
+    constexpr char unknownPrimitivesJson[] = "{\"other\": [true, false, null, 0, -1, 12.5, -0.25e-3, 1E+2, 7e1], \"name\": \"name\", \"count\": 42, \"levels\": [1]}";
+    const char * const invalidUnknownJson[] = {
+        "{\"unknown\": xyz}",
+        "{\"unknown\": tru}",
+        "{\"unknown\": nulls}",
+        "{\"unknown\": 01}",
+        "{\"unknown\": -}",
+        "{\"unknown\": 1.}",
+        "{\"unknown\": .5}",
+        "{\"unknown\": 1e}",
+        "{\"unknown\": +1}"
+    };
+    constexpr char repeatedMemberJson[] = "{\"count\": 1, \"name\": \"name\", \"count\": 42, \"levels\": [1]}";
+    constexpr char unknownEscapesJson[] = "{\"other\": {\"a\\tb\": \"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u00e9\\uABcd\"}, \"name\": \"name\", \"count\": 42, \"levels\": [1]}";
+    const char * const invalidUnknownStringJson[] = {
+        "{\"unknown\": \"bad\\q\"}",
+        "{\"unknown\": \"raw \x01 byte\"}",
+        "{\"unknown\": \"\\u12g4\"}",
+        "{\"unknown\": \"\\u12\"}",
+        "{\"other\": {\"bad\\q\": 1}}"
+    };
+    constexpr char invalidLevelsJson[] = "{\"name\": \"name\", \"count\": 42, \"levels\": [1, {\"a\": 1}, 2]}";
+    constexpr char missingCountJson[] = "{\"levels\": [1], \"name\": \"name\"}";
+    constexpr char invalidJson[] = "{\"name\": \"name\" \"count\": 42}";
+    constexpr char truncatedJson[] = "{\"name\": \"name\", \"count\": 4";
+    constexpr char macAddressBytesJson[] = "[18, 52, 5, 120, 154, 188]";
+    constexpr uint8_t macAddressBytes[BurpSerialization::MAC_ADDRESS_BYTE_COUNT] = {0x12, 0x34, 0x05, 0x78, 0x9a, 0xbc};
+
+    class Parser : public BurpSerialization::Parser {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                incomplete,
+                invalidInput,
+                tooDeep,
+                noMemory,
+                notPresent,
+                wrongType,
+                nameNotPresent,
+                nameWrongType,
+                nameTooShort,
+                nameTooLong,
+                countNotPresent,
+                countWrongType,
+                levelsNotPresent,
+                levelsWrongType,
+                levelsTooLong,
+                levelsTooShort,
+                levelZero,
+                levelNotIncreasing,
+                levelNotPresent,
+                levelWrongType
+            };
+
+            struct {
+                bool isNull;
+                const char * name;
+                BurpSerialization::Scalar<int>::Value count;
+                BurpSerialization::PWMLevels::Value levels;
+            } obj;
+
+            Parser(char * buffer, size_t size) :
+                BurpSerialization::Parser(_obj, buffer, size, {
+                    ok,
+                    incomplete,
+                    invalidInput,
+                    tooDeep,
+                    noMemory
+                }),
+                _name(1, 16, {
+                    ok,
+                    nameNotPresent,
+                    nameWrongType,
+                    nameTooShort,
+                    nameTooLong
+                }, obj.name),
+                _count({
+                    ok,
+                    countNotPresent,
+                    countWrongType
+                }, obj.count),
+                _levels({
+                    ok,
+                    levelsNotPresent,
+                    levelsWrongType,
+                    levelsTooLong,
+                    levelsTooShort,
+                    levelZero,
+                    levelNotIncreasing,
+                    levelNotPresent,
+                    levelWrongType
+                }, obj.levels),
+                _obj({
+                    Object::Entry({nameName, &_name}),
+                    Object::Entry({countName, &_count}),
+                    Object::Entry({levelsName, &_levels})
+                }, {
+                    ok,
+                    notPresent,
+                    wrongType
+                }, obj.isNull)
+            {}
+
+            BurpStatus::Status::Code parse(const char * json, size_t chunkSize) {
+                begin();
+                auto length = strlen(json);
+                for (size_t pos = 0; pos < length; pos += chunkSize) {
+                    auto code = write(json + pos, pos + chunkSize < length ? chunkSize : length - pos);
+                    if (code != ok) return code;
+                }
+                return end();
+            }
+
+        private:
+
+            using Object = BurpSerialization::Object<3>;
+
+            const BurpSerialization::CStr _name;
+            const BurpSerialization::Scalar<int> _count;
+            const BurpSerialization::PWMLevels _levels;
+            const Object _obj;
+
+    };
+
+    Module tests("Parser", [](Describe & d) {
+        d.describe("with a valid document in one chunk", [](Describe & d) {
+            d.it("should have the correct values", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(validJson, sizeof(validJson));
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                TEST_ASSERT_FALSE(parser.obj.isNull);
+                TEST_ASSERT_EQUAL_STRING(validName, parser.obj.name);
+                TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+                TEST_ASSERT_EQUAL(3, parser.obj.levels.length);
+                TEST_ASSERT_EQUAL(3, parser.obj.levels.list[2]);
+            });
+        });
+        d.describe("with a valid document one byte at a time", [](Describe & d) {
+            d.it("should have the correct values", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(validJson, 1);
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                TEST_ASSERT_FALSE(parser.obj.isNull);
+                TEST_ASSERT_EQUAL_STRING(validName, parser.obj.name);
+                TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+                TEST_ASSERT_EQUAL(3, parser.obj.levels.length);
+            });
+        });
+        d.describe("with unknown members", [](Describe & d) {
+            d.describe("with containers", [](Describe & d) {
+                d.it("should skip them", []() {
+                    char buffer[bufferSize];
+                    Parser parser(buffer, bufferSize);
+                    auto code = parser.parse(unknownMembersJson, 5);
+                    TEST_ASSERT_EQUAL(Parser::ok, code);
+                    TEST_ASSERT_EQUAL_STRING("name", parser.obj.name);
+                    TEST_ASSERT_EQUAL(1, parser.obj.levels.length);
+                });
+            });
+            d.describe("with every kind of primitive", [](Describe & d) {
+                d.it("should skip them", []() {
+                    char buffer[bufferSize];
+                    Parser parser(buffer, bufferSize);
+                    auto code = parser.parse(unknownPrimitivesJson, 3);
+                    TEST_ASSERT_EQUAL(Parser::ok, code);
+                    TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+                });
+            });
+            d.describe("with escapes in strings", [](Describe & d) {
+                d.it("should skip them", []() {
+                    char buffer[bufferSize];
+                    Parser parser(buffer, bufferSize);
+                    auto code = parser.parse(unknownEscapesJson, 3);
+                    TEST_ASSERT_EQUAL(Parser::ok, code);
+                    TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+                });
+            });
+            d.describe("with a string that is not JSON", [](Describe & d) {
+                for (auto json : invalidUnknownStringJson) {
+                    d.it(json, [=]() {
+                        char buffer[bufferSize];
+                        Parser parser(buffer, bufferSize);
+                        auto code = parser.parse(json, 2);
+                        TEST_ASSERT_EQUAL(Parser::invalidInput, code);
+                    });
+                }
+            });
+            d.describe("with a primitive that is not JSON", [](Describe & d) {
+                for (auto json : invalidUnknownJson) {
+                    d.it(json, [=]() {
+                        char buffer[bufferSize];
+                        Parser parser(buffer, bufferSize);
+                        auto code = parser.parse(json, 2);
+                        TEST_ASSERT_EQUAL(Parser::invalidInput, code);
+                    });
+                }
+            });
+        });
+        d.describe("with a repeated member", [](Describe & d) {
+            d.it("should keep the last value", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(repeatedMemberJson, 4);
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                TEST_ASSERT_EQUAL(validCount, parser.obj.count.value);
+            });
+        });
+        d.describe("with a container in place of a level", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(invalidLevelsJson, 7);
+                TEST_ASSERT_EQUAL(Parser::levelWrongType, code);
+                TEST_ASSERT_TRUE(parser.obj.levels.isNull);
+            });
+        });
+        d.describe("with a missing member", [](Describe & d) {
+            d.it("should fail with the field code", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(missingCountJson, 3);
+                TEST_ASSERT_EQUAL(Parser::countNotPresent, code);
+                TEST_ASSERT_FALSE(parser.obj.isNull);
+                TEST_ASSERT_TRUE(parser.obj.count.isNull);
+                TEST_ASSERT_EQUAL_STRING("name", parser.obj.name);
+            });
+        });
+        d.describe("with invalid JSON", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(invalidJson, 4);
+                TEST_ASSERT_EQUAL(Parser::invalidInput, code);
+            });
+        });
+        d.describe("with a truncated document", [](Describe & d) {
+            d.it("should be incomplete", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse(truncatedJson, 4);
+                TEST_ASSERT_EQUAL(Parser::incomplete, code);
+            });
+        });
+        d.describe("with a buffer that is too small", [](Describe & d) {
+            d.it("should fail", []() {
+                char buffer[smallBufferSize];
+                Parser parser(buffer, smallBufferSize);
+                auto code = parser.parse(validJson, 4);
+                TEST_ASSERT_EQUAL(Parser::noMemory, code);
+            });
+        });
+        d.describe("with a scalar at the root", [](Describe & d) {
+            d.it("should fail with the wrong type", []() {
+                char buffer[bufferSize];
+                Parser parser(buffer, bufferSize);
+                auto code = parser.parse("42", 1);
+                TEST_ASSERT_EQUAL(Parser::wrongType, code);
+                TEST_ASSERT_TRUE(parser.obj.isNull);
+            });
+        });
+        d.describe("with a MacAddress as an array of bytes", [](Describe & d) {
+            d.it("should read each byte", []() {
+                char buffer[bufferSize];
+                BurpSerialization::MacAddress::Value value;
+                BurpSerialization::MacAddress field({
+                    Parser::ok,
+                    Parser::notPresent,
+                    Parser::wrongType,
+                    Parser::invalidInput,
+                    Parser::invalidInput,
+                    Parser::invalidInput,
+                    Parser::invalidInput,
+                    Parser::invalidInput
+                }, value);
+                BurpSerialization::Parser parser(field, buffer, bufferSize, {
+                    Parser::ok,
+                    Parser::incomplete,
+                    Parser::invalidInput,
+                    Parser::tooDeep,
+                    Parser::noMemory
+                });
+                parser.begin();
+                parser.write(macAddressBytesJson, strlen(macAddressBytesJson));
+                auto code = parser.end();
+                TEST_ASSERT_EQUAL(Parser::ok, code);
+                TEST_ASSERT_FALSE(value.isNull);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(macAddressBytes, value.value, BurpSerialization::MAC_ADDRESS_BYTE_COUNT);
+            });
+        });
+    });
+
+}
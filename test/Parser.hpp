@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace Parser {
+    
+  extern Module tests;
+
+}
@@ -35,6 +35,7 @@ namespace Scalar {
     };
 
     constexpr size_t docSize = 128;
+    constexpr size_t bufferSize = 32;
     constexpr char fieldName[] = "field";
 
     template <class Type, size_t valueCount, size_t docSize>
@@ -132,6 +133,36 @@ namespace Scalar {
                         });
                     });
                 });
+
+                d.describe("write", [&](Describe & d) {
+                    d.describe("without a value", [&](Describe & d) {
+                        d.it("should write null", [&]() {
+                            Serialization<Type> serialization;
+                            char buffer[bufferSize];
+                            BurpSerialization::Writer writer(buffer, bufferSize);
+                            serialization.scalar.isNull = true;
+                            auto success = serialization.serialize(writer);
+                            TEST_ASSERT_TRUE(success);
+                            TEST_ASSERT_EQUAL_STRING("null", buffer);
+                        });
+                    });
+                    for (auto & scenario : _scenarios) {
+                        d.describe(scenario.description, [&](Describe & d) {
+                            d.it("should write JSON text that reads back the same", [&]() {
+                                Serialization<Type> serialization;
+                                char buffer[bufferSize];
+                                BurpSerialization::Writer writer(buffer, bufferSize);
+                                serialization.scalar.value = scenario.value;
+                                auto success = serialization.serialize(writer);
+                                TEST_ASSERT_TRUE(success);
+                                StaticJsonDocument<docSize> doc;
+                                deserializeJson(doc, static_cast<const char *>(buffer));
+                                TEST_ASSERT_TRUE(doc.template is<Type>());
+                                TEST_ASSERT_EQUAL(scenario.value, doc.template as<Type>());
+                            });
+                        });
+                    }
+                });
             });
         }
 
@@ -0,0 +1,277 @@
+#include <unity.h>
+#include "../src/BurpSerialization/StaticObject.hpp"
+#include "../src/BurpSerialization/StaticSerialization.hpp"
+#include "../src/BurpSerialization/Scalar.hpp"
+#include "../src/BurpSerialization/Parser.hpp"
+#include "TestField.hpp"
+#include "StaticObject.hpp"
+
+namespace StaticObject {
+
+    constexpr size_t docSize = 256;
+    constexpr size_t bufferSize = 128;
+    constexpr char fieldName[] = "field";
+    constexpr char fieldOneName[] = "one";
+    constexpr char fieldTwoName[] = "two";
+    constexpr char nestedName[] = "nested";
+    constexpr char countName[] = "count";
+    constexpr char unknownName[] = "three";
+    constexpr int invalidCStr = 100;
+    constexpr int validCount = 42;
+    constexpr char validOneCStr[] = "one value";
+    constexpr char validTwoCStr[] = "two value";
+    constexpr char validJson[] = "{\"one\":\"one value\",\"two\":null,\"nested\":{\"count\":42}}";
+
+    class Serialization : public BurpSerialization::StaticSerialization<BurpSerialization::StaticObject<TestField, TestField, BurpSerialization::StaticObject<BurpSerialization::Scalar<int>>>> {
+
+        public:
+
+            enum : BurpStatus::Status::Code {
+                ok,
+                notPresent,
+                wrongType,
+                fieldOneNotPresent,
+                fieldOneWrongType,
+                fieldTwoNotPresent,
+                fieldTwoWrongType,
+                nestedNotPresent,
+                nestedWrongType,
+                countNotPresent,
+                countWrongType
+            };
+
+            using Nested = BurpSerialization::StaticObject<BurpSerialization::Scalar<int>>;
+            using Object = BurpSerialization::StaticObject<TestField, TestField, Nested>;
+
+            struct {
+                bool isNull;
+                const char * fieldOne;
+                const char * fieldTwo;
+                struct {
+                    bool isNull;
+                    BurpSerialization::Scalar<int>::Value count;
+                } nested;
+            } obj = {};
+
+            Serialization(const Mode mode = Mode::collectAll) :
+                BurpSerialization::StaticSerialization<Object>(_obj, mode),
+                _fieldOne({ok, fieldOneNotPresent, fieldOneWrongType}, obj.fieldOne),
+                _fieldTwo({ok, fieldTwoNotPresent, fieldTwoWrongType}, obj.fieldTwo),
+                _count({ok, countNotPresent, countWrongType}, obj.nested.count),
+                _nested({countName}, Nested::Members(_count), {ok, nestedNotPresent, nestedWrongType}, obj.nested.isNull),
+                _obj({fieldOneName, fieldTwoName, nestedName}, Object::Members(_fieldOne, _fieldTwo, _nested), {ok, notPresent, wrongType}, obj.isNull)
+            {}
+
+            const Object & root() const {
+                return _obj;
+            }
+
+            void set() {
+                obj.isNull = false;
+                obj.fieldOne = validOneCStr;
+                obj.fieldTwo = nullptr;
+                obj.nested.isNull = false;
+                obj.nested.count.isNull = false;
+                obj.nested.count.value = validCount;
+            }
+
+        private:
+
+            const TestField _fieldOne;
+            const TestField _fieldTwo;
+            const BurpSerialization::Scalar<int> _count;
+            const Nested _nested;
+            const Object _obj;
+
+    };
+
+    Module tests("StaticObject", [](Describe & d) {
+        d.describe("deserialize", [](Describe & d) {
+            d.describe("when not present", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<1> doc;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::notPresent, code);
+                });
+            });
+            d.describe("with an invalid value", [](Describe & d) {
+                d.it("should fail and not be present", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = invalidCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::wrongType, code);
+                });
+            });
+            d.describe("when sub fields are not present", [](Describe & d) {
+                d.it("should report the last in entry order", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_NULL(serialization.obj.fieldTwo);
+                    TEST_ASSERT_TRUE(serialization.obj.nested.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::nestedNotPresent, code);
+                });
+            });
+            d.describe("with a nested sub field that is invalid", [](Describe & d) {
+                d.it("should pass up its code", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][nestedName][countName] = validOneCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.nested.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::countWrongType, code);
+                });
+            });
+            d.describe("with members in reverse order and unknown members", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][nestedName][countName] = validCount;
+                    doc[fieldName][unknownName] = invalidCStr;
+                    doc[fieldName][fieldTwoName] = validTwoCStr;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL_STRING(validTwoCStr, serialization.obj.fieldTwo);
+                    TEST_ASSERT_EQUAL(validCount, serialization.obj.nested.count.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+        });
+
+        d.describe("deserialize fail fast", [](Describe & d) {
+            d.describe("when several sub fields fail", [](Describe & d) {
+                d.it("should report the first failure in document order and stay null", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][nestedName][countName] = validOneCStr;
+                    doc[fieldName][fieldOneName] = invalidCStr;
+                    auto code = serialization.deserialize(doc[fieldName]);
+                    TEST_ASSERT_TRUE(serialization.obj.isNull);
+                    TEST_ASSERT_NULL(serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL(Serialization::countWrongType, code);
+                });
+            });
+            d.describe("with a required member that is null", [](Describe & d) {
+                d.it("should not read the later members", []() {
+                    Serialization serialization(Serialization::Mode::failFast);
+                    StaticJsonDocument<docSize> doc;
+                    deserializeJson(doc, validJson);
+                    auto code = serialization.deserialize(doc.as<JsonVariant>());
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL(0, serialization.obj.nested.count.value);
+                    TEST_ASSERT_EQUAL(Serialization::fieldTwoNotPresent, code);
+                });
+            });
+        });
+
+        d.describe("deserialize patch", [](Describe & d) {
+            d.describe("with a nested member", [](Describe & d) {
+                d.it("should change only that member", []() {
+                    Serialization serialization;
+                    serialization.set();
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][nestedName][countName] = validCount + 1;
+                    auto code = serialization.deserializePatch(doc[fieldName]);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL(validCount + 1, serialization.obj.nested.count.value);
+                    TEST_ASSERT_EQUAL(Serialization::ok, code);
+                });
+            });
+            d.describe("with a null object", [](Describe & d) {
+                d.it("should check the members not in the patch as not present", []() {
+                    Serialization serialization;
+                    serialization.obj.isNull = true;
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName][fieldOneName] = validOneCStr;
+                    auto code = serialization.deserializePatch(doc[fieldName]);
+                    TEST_ASSERT_FALSE(serialization.obj.isNull);
+                    TEST_ASSERT_TRUE(serialization.obj.nested.isNull);
+                    TEST_ASSERT_EQUAL(Serialization::nestedNotPresent, code);
+                });
+            });
+        });
+
+        d.describe("serialize", [](Describe & d) {
+            d.describe("without a value", [](Describe & d) {
+                d.it("should set the value in the JSON document to NULL", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.obj.isNull = true;
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_TRUE(doc[fieldName].isNull());
+                });
+            });
+            d.describe("with values", [](Describe & d) {
+                d.it("should set the values in the JSON document", []() {
+                    Serialization serialization;
+                    StaticJsonDocument<docSize> doc;
+                    serialization.set();
+                    auto success = serialization.serialize(doc[fieldName].to<JsonVariant>());
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, doc[fieldName][fieldOneName]);
+                    TEST_ASSERT_TRUE(doc[fieldName][fieldTwoName].isNull());
+                    TEST_ASSERT_EQUAL(validCount, doc[fieldName][nestedName][countName].as<int>());
+                });
+            });
+        });
+
+        d.describe("write", [](Describe & d) {
+            d.describe("with values", [](Describe & d) {
+                d.it("should write the same JSON text as Object", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Writer writer(buffer, bufferSize);
+                    serialization.set();
+                    auto success = serialization.serialize(writer);
+                    TEST_ASSERT_TRUE(success);
+                    TEST_ASSERT_EQUAL_STRING(validJson, buffer);
+                });
+            });
+        });
+
+        d.describe("through the Object base", [](Describe & d) {
+            d.describe("with Parser", [](Describe & d) {
+                d.it("should have the correct values", []() {
+                    Serialization serialization;
+                    char buffer[bufferSize];
+                    BurpSerialization::Parser parser(serialization.root(), buffer, bufferSize, {0, 1, 2, 3, 4});
+                    parser.begin();
+                    parser.write(validJson, sizeof(validJson) - 1);
+                    auto code = parser.end();
+                    TEST_ASSERT_EQUAL(Serialization::fieldTwoNotPresent, code);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL(validCount, serialization.obj.nested.count.value);
+                });
+            });
+            d.describe("with the binary codec", [](Describe & d) {
+                d.it("should read back the same values", []() {
+                    Serialization serialization;
+                    uint8_t buffer[bufferSize];
+                    char strings[bufferSize];
+                    serialization.set();
+                    BurpSerialization::BinaryEncoder encoder(buffer, bufferSize);
+                    TEST_ASSERT_TRUE(serialization.serialize(encoder));
+                    serialization.obj.nested.count.value = 0;
+                    BurpSerialization::BinaryDecoder decoder(strings, bufferSize, {0, 1, 2, 3, 4});
+                    auto code = serialization.deserialize(decoder, buffer, encoder.length());
+                    TEST_ASSERT_EQUAL(validCount, serialization.obj.nested.count.value);
+                    TEST_ASSERT_EQUAL_STRING(validOneCStr, serialization.obj.fieldOne);
+                    TEST_ASSERT_EQUAL(Serialization::fieldTwoNotPresent, code);
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <unity.h>
+#include "../src/BurpSerialization/StringPool.hpp"
+#include "../src/BurpSerialization/CStr.hpp"
+#include "StringPool.hpp"
+
+namespace StringPool {
+
+    constexpr size_t docSize = 128;
+    constexpr size_t arenaSize = 32;
+    constexpr size_t slotCount = 8;
+    constexpr char fieldName[] = "field";
+    constexpr char kitchen[] = "kitchen";
+    constexpr char hall[] = "hall";
+    constexpr char longValue[] = "a value that is longer than the whole arena";
+
+    using Pool = BurpSerialization::StaticStringPool<arenaSize, slotCount>;
+
+    Module tests("StringPool", [](Describe & d) {
+        d.describe("intern", [](Describe & d) {
+            d.describe("a new string", [](Describe & d) {
+                d.it("should copy it into the arena", []() {
+                    Pool pool;
+                    char value[] = "kitchen";
+                    auto interned = pool.intern(value);
+                    TEST_ASSERT_TRUE(interned != value);
+                    TEST_ASSERT_EQUAL_STRING(kitchen, interned);
+                    TEST_ASSERT_EQUAL(1, pool.stats().strings);
+                    TEST_ASSERT_EQUAL(sizeof(kitchen), pool.stats().bytesUsed);
+                    TEST_ASSERT_EQUAL(0, pool.stats().hits);
+                });
+            });
+            d.describe("the same string again", [](Describe & d) {
+                d.it("should return the same pointer and count a hit", []() {
+                    Pool pool;
+                    char first[] = "kitchen";
+                    char second[] = "kitchen";
+                    auto one = pool.intern(first);
+                    auto two = pool.intern(second);
+                    TEST_ASSERT_TRUE(one == two);
+                    TEST_ASSERT_EQUAL(2, pool.stats().lookups);
+                    TEST_ASSERT_EQUAL(1, pool.stats().hits);
+                    TEST_ASSERT_EQUAL(sizeof(kitchen), pool.stats().bytesSaved);
+                    TEST_ASSERT_EQUAL(sizeof(kitchen), pool.stats().bytesUsed);
+                });
+            });
+            d.describe("different strings", [](Describe & d) {
+                d.it("should return different pointers", []() {
+                    Pool pool;
+                    auto one = pool.intern(kitchen);
+                    auto two = pool.intern(hall);
+                    TEST_ASSERT_TRUE(one != two);
+                    TEST_ASSERT_EQUAL_STRING(kitchen, one);
+                    TEST_ASSERT_EQUAL_STRING(hall, two);
+                    TEST_ASSERT_EQUAL(2, pool.stats().strings);
+                });
+            });
+            d.describe("a prefix of an interned string", [](Describe & d) {
+                d.it("should intern it separately", []() {
+                    Pool pool;
+                    auto one = pool.intern(kitchen);
+                    auto two = pool.intern(kitchen, 4);
+                    TEST_ASSERT_TRUE(one != two);
+                    TEST_ASSERT_EQUAL_STRING("kitc", two);
+                    TEST_ASSERT_EQUAL(0, pool.stats().hits);
+                });
+            });
+            d.describe("a string that does not fit in the arena", [](Describe & d) {
+                d.it("should return nullptr and count it as dropped", []() {
+                    Pool pool;
+                    auto interned = pool.intern(longValue);
+                    TEST_ASSERT_NULL(interned);
+                    TEST_ASSERT_EQUAL(1, pool.stats().dropped);
+                    TEST_ASSERT_EQUAL(0, pool.stats().bytesUsed);
+                });
+            });
+            d.describe("more strings than 3/4 of the slots", [](Describe & d) {
+                d.it("should return nullptr and count it as dropped", []() {
+                    Pool pool;
+                    const char * values[] = {"a", "b", "c", "d", "e", "f", "g"};
+                    for (auto value : values) pool.intern(value);
+                    TEST_ASSERT_EQUAL(6, pool.stats().strings);
+                    TEST_ASSERT_EQUAL(1, pool.stats().dropped);
+                    TEST_ASSERT_NOT_NULL(pool.intern("a"));
+                });
+            });
+        });
+        d.describe("reset", [](Describe & d) {
+            d.it("should forget the strings and the counts", []() {
+                Pool pool;
+                pool.intern(kitchen);
+                pool.intern(kitchen);
+                pool.reset();
+                TEST_ASSERT_EQUAL(0, pool.stats().lookups);
+                TEST_ASSERT_EQUAL(0, pool.stats().bytesUsed);
+                pool.intern(kitchen);
+                TEST_ASSERT_EQUAL(0, pool.stats().hits);
+                TEST_ASSERT_EQUAL(1, pool.stats().strings);
+            });
+        });
+        d.describe("with CStr", [](Describe & d) {
+            d.describe("deserializing the same value from two documents", [](Describe & d) {
+                d.it("should hold one interned pointer", []() {
+                    Pool pool;
+                    const char * one;
+                    const char * two;
+                    BurpSerialization::CStr fieldOne(0, 16, {0, 1, 2, 3, 4}, one, &pool);
+                    BurpSerialization::CStr fieldTwo(0, 16, {0, 1, 2, 3, 4}, two, &pool);
+                    {
+                        StaticJsonDocument<docSize> doc;
+                        char json[] = "{\"field\":\"kitchen\"}";
+                        deserializeJson(doc, json);
+                        TEST_ASSERT_EQUAL(0, fieldOne.deserialize(doc[fieldName]));
+                        memset(json, 0, sizeof(json));
+                    }
+                    {
+                        StaticJsonDocument<docSize> doc;
+                        char json[] = "{\"field\":\"kitchen\"}";
+                        deserializeJson(doc, json);
+                        TEST_ASSERT_EQUAL(0, fieldTwo.deserialize(doc[fieldName]));
+                    }
+                    TEST_ASSERT_TRUE(one == two);
+                    TEST_ASSERT_EQUAL_STRING(kitchen, one);
+                    TEST_ASSERT_EQUAL(1, pool.stats().hits);
+                });
+            });
+            d.describe("when the pool is full", [](Describe & d) {
+                d.it("should fall back to the document string", []() {
+                    Pool pool;
+                    const char * value;
+                    BurpSerialization::CStr field(0, 64, {0, 1, 2, 3, 4}, value, &pool);
+                    StaticJsonDocument<docSize> doc;
+                    doc[fieldName] = longValue;
+                    auto code = field.deserialize(doc[fieldName]);
+                    TEST_ASSERT_EQUAL(0, code);
+                    TEST_ASSERT_TRUE(value == longValue);
+                    TEST_ASSERT_EQUAL(1, pool.stats().dropped);
+                });
+            });
+        });
+    });
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <BurpUnity.hpp>
+
+namespace StringPool {
+    
+  extern Module tests;
+
+}
\ No newline at end of file
@@ -26,19 +26,49 @@
 #include "Scalar.hpp"
 #include "CStr.hpp"
 #include "CStrMap.hpp"
+#include "IndexedCStrMap.hpp"
 #include "IPv4.hpp"
 #include "MacAddress.hpp"
 #include "PWMLevels.hpp"
 #include "Object.hpp"
+#include "Parser.hpp"
+#include "MsgPackParser.hpp"
+#include "BinaryDecoder.hpp"
+#include "Capacity.hpp"
+#include "MemoryAccounting.hpp"
+#include "StaticObject.hpp"
+#include "Codes.hpp"
+#include "OwnedCStr.hpp"
+#include "StringPool.hpp"
+#include "Delta.hpp"
+#include "Array.hpp"
+#include "CachedIPv4.hpp"
+#include "CachedMacAddress.hpp"
+#include "JsonLines.hpp"
 
-Runner<7> runner({
+Runner<22> runner({
     &Scalar::tests,
     &CStr::tests,
     &CStrMap::tests,
+    &IndexedCStrMap::tests,
     &IPv4::tests,
     &MacAddress::tests,
     &PWMLevels::tests,
     &Object::tests,
+    &Parser::tests,
+    &MsgPackParser::tests,
+    &BinaryDecoder::tests,
+    &Capacity::tests,
+    &MemoryAccounting::tests,
+    &StaticObject::tests,
+    &Codes::tests,
+    &OwnedCStr::tests,
+    &StringPool::tests,
+    &Delta::tests,
+    &Array::tests,
+    &CachedIPv4::tests,
+    &CachedMacAddress::tests,
+    &JsonLines::tests,
 });
 Memory memory;
 bool running = true;